@@ -131,7 +131,7 @@ namespace jrmwng
                     {
                         // NOP: first, *value*, parition_point_1, partition_point_2, ..., partition_point_n, last
                     }
-                    if (nIndex1 < sizeof...(zuPARTITION_i))
+                    if (nIndex1 < static_cast<int>(sizeof...(zuPARTITION_i)))
                     {
                         // Move the last iterator to the left of the partition point that is next to the last partition point that satisfies the comparison.
                         last = iters[nIndex1];
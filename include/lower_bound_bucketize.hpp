@@ -0,0 +1,168 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound and simd::details::simd_traits
+
+#include <array>            // for std::array
+#include <span>             // for std::span
+#include <ranges>           // for std::ranges::contiguous_range, std::ranges::random_access_range
+#include <bit>              // for std::popcount
+#include <utility>          // for std::index_sequence, std::make_index_sequence
+#include <algorithm>        // for std::min
+#include <stdexcept>        // for std::invalid_argument
+#include <type_traits>      // for std::is_same_v
+
+/**
+ * @file lower_bound_bucketize.hpp
+ * @brief Provides bucketize (searchsorted) of a stream of values against a small sorted set of boundaries.
+ *
+ * Calling simd::lower_bound once per value repeats the loop setup and the loads of the boundaries for every value.
+ * bucketize loads the boundaries into SIMD registers once; each value is then broadcast and compared against every
+ * boundary register, and the popcounts of the less-than masks add up to the value's bucket. Values are processed in
+ * batches so the compares of independent values overlap. Boundary sets too large for the register budget fall back
+ * to the n-ary engine per value.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace simd
+        {
+            namespace details
+            {
+                /**
+                 * @brief The number of boundary registers kept live, leaving the other half of the 16 vector registers for values.
+                 */
+                constexpr size_t bucketize_registers_v = 8;
+
+                /**
+                 * @brief The number of values bucketized per batch.
+                 */
+                constexpr size_t bucketize_batch_v = 8;
+
+                /**
+                 * @brief Loads one register of boundaries from a padded buffer.
+                 */
+                template <typename T, size_t... zuLANE_i>
+                typename simd_traits<T>::simd_type load_boundaries(T const * const pBoundary, std::index_sequence<zuLANE_i...>)
+                {
+                    return simd_traits<T>::setr(pBoundary[zuLANE_i]...);
+                }
+
+                /**
+                 * @brief Bucketizes values against boundaries held in zuREGISTERS registers.
+                 *
+                 * @param boundaries The sorted boundaries; at most zuREGISTERS registers' worth.
+                 * @param values The values.
+                 * @param itOut Receives, for each value, the number of boundaries less than it.
+                 */
+                template <size_t zuREGISTERS, typename T, typename Toutput>
+                void bucketize_registers(std::span<T const> const boundaries, std::span<T const> const values, Toutput itOut)
+                {
+                    using traits_type = simd_traits<T>;
+                    using simd_type = typename traits_type::simd_type;
+                    constexpr size_t simd_size_v = traits_type::simd_size_v;
+
+                    // Pad the last register by repeating the last boundary; its padding lanes are masked off.
+                    std::array<T, zuREGISTERS * simd_size_v> aPadded;
+                    for (size_t i = 0; i < aPadded.size(); ++i)
+                    {
+                        aPadded[i] = boundaries[std::min(i, boundaries.size() - 1)];
+                    }
+                    // A plain array: std::array<simd_type, ...> would drop the vector type's attributes (-Wignored-attributes).
+                    simd_type aBoundary[zuREGISTERS];
+                    for (size_t uRegister = 0; uRegister < zuREGISTERS; ++uRegister)
+                    {
+                        aBoundary[uRegister] = load_boundaries(aPadded.data() + uRegister * simd_size_v, std::make_index_sequence<simd_size_v>{});
+                    }
+                    unsigned const uLastMask = (1u << (boundaries.size() - (zuREGISTERS - 1) * simd_size_v)) - 1;
+
+                    auto const fnBucket = [&](T const & tValue)
+                    {
+                        simd_type const simdValue = traits_type::set1(tValue);
+                        int nBucket = 0;
+                        for (size_t uRegister = 0; uRegister + 1 < zuREGISTERS; ++uRegister)
+                        {
+                            nBucket += std::popcount(static_cast<unsigned>(traits_type::cmp_lt(aBoundary[uRegister], simdValue)));
+                        }
+                        return nBucket + std::popcount(static_cast<unsigned>(traits_type::cmp_lt(aBoundary[zuREGISTERS - 1], simdValue)) & uLastMask);
+                    };
+
+                    size_t i = 0;
+                    for (; i + bucketize_batch_v <= values.size(); i += bucketize_batch_v)
+                    {
+                        std::array<int, bucketize_batch_v> aBucket;
+                        for (size_t j = 0; j < bucketize_batch_v; ++j)
+                        {
+                            aBucket[j] = fnBucket(values[i + j]);
+                        }
+                        for (size_t j = 0; j < bucketize_batch_v; ++j)
+                        {
+                            itOut[i + j] = aBucket[j];
+                        }
+                    }
+                    for (; i < values.size(); ++i)
+                    {
+                        itOut[i] = fnBucket(values[i]);
+                    }
+                }
+            }
+
+            /**
+             * @brief The largest boundary set of type T that bucketize keeps in registers.
+             */
+            template <typename T>
+            constexpr size_t bucketize_register_capacity_v = details::bucketize_registers_v * details::simd_traits<T>::simd_size_v;
+
+            /**
+             * @brief Assigns each value the index of its bucket, i.e. the number of boundaries less than the value.
+             *
+             * The result for each value equals the position std::lower_bound would return in the boundaries.
+             *
+             * @param boundaries The sorted boundaries.
+             * @param values The values to bucketize.
+             * @param out Receives one bucket index per value; must be at least as long as values.
+             *
+             * @example
+             * std::vector<float> boundaries = {0.0f, 10.0f, 20.0f};
+             * std::vector<float> values = {-1.0f, 5.0f, 10.0f, 25.0f};
+             * std::vector<uint8_t> buckets(values.size());
+             * jrmwng::algorithm::simd::bucketize(boundaries, values, buckets); // 0, 1, 1, 3
+             */
+            template <typename Boundaries, typename Values, typename Output>
+            requires std::ranges::contiguous_range<Boundaries> && std::ranges::contiguous_range<Values> && std::ranges::random_access_range<Output>
+            void bucketize(Boundaries const & boundaries, Values const & values, Output && out)
+            {
+                using T = std::ranges::range_value_t<Boundaries>;
+                static_assert(std::is_same_v<T, std::ranges::range_value_t<Values>>, "Boundaries and values must have the same type");
+
+                std::span<T const> const spanBoundary(std::ranges::data(boundaries), std::ranges::size(boundaries));
+                std::span<T const> const spanValue(std::ranges::data(values), std::ranges::size(values));
+                if (static_cast<size_t>(std::ranges::size(out)) < spanValue.size())
+                {
+                    throw std::invalid_argument("bucketize: the output is shorter than the values");
+                }
+                auto const itOut = std::ranges::begin(out);
+
+                if constexpr (requires { typename details::simd_traits<T>::simd_type; })
+                {
+                    constexpr size_t simd_size_v = details::simd_traits<T>::simd_size_v;
+                    size_t const uRegisters = (spanBoundary.size() + simd_size_v - 1) / simd_size_v;
+                    if (uRegisters >= 1 && uRegisters <= details::bucketize_registers_v)
+                    {
+                        // Instantiate one kernel per register count, so the boundary loop fully unrolls.
+                        [&]<size_t... zuREGISTER_i>(std::index_sequence<zuREGISTER_i...>)
+                        {
+                            static_cast<void>(((uRegisters == zuREGISTER_i + 1 && (details::bucketize_registers<zuREGISTER_i + 1>(spanBoundary, spanValue, itOut), true)) || ...));
+                        }(std::make_index_sequence<details::bucketize_registers_v>{});
+                        return;
+                    }
+                }
+                for (size_t i = 0; i < spanValue.size(); ++i)
+                {
+                    itOut[i] = static_cast<size_t>(simd::lower_bound(spanBoundary, spanValue[i]) - spanBoundary.begin());
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "lower_bound_normalize.hpp" // Project-specific header for keys::normalize
+#include "lower_bound_parallel.hpp"  // Project-specific header for parallel::parallel_for
+
+#include <span>             // for std::span
+#include <vector>           // for std::vector
+#include <array>            // for std::array
+#include <thread>           // for std::thread::hardware_concurrency
+#include <atomic>           // for std::atomic
+#include <bit>              // for std::bit_width
+#include <numeric>          // for std::iota
+#include <limits>           // for std::numeric_limits
+#include <utility>          // for std::exchange, std::swap
+#include <algorithm>        // for std::sort, std::find, std::min_element, std::max_element, std::merge, std::unique, std::copy, std::min, std::max
+#include <functional>       // for std::less
+#include <filesystem>       // for std::filesystem::path, std::filesystem::file_size
+#include <fstream>          // for std::ifstream
+#include <stdexcept>        // for std::runtime_error
+#include <type_traits>      // for std::is_same_v, std::is_trivially_copyable_v
+
+/**
+ * @file lower_bound_bulk_load.hpp
+ * @brief Provides a parallel pipeline turning unsorted keys, in memory or in a file, into the sorted, optionally deduplicated
+ * array every search layout is built from.
+ *
+ * Keys supported by keys::normalize are radix sorted: the threads histogram their share of the keys by the top bits of the
+ * normalized offset from the smallest key, scatter them into 2^11 buckets of a buffer, then take whole buckets from a
+ * shared counter and finish each with byte-wise LSD radix passes, skipping the bytes a bucket does not vary in. Other keys,
+ * or other orders, are sorted in per-thread chunks merged pairwise in parallel. Deduplication runs std::unique per chunk,
+ * then drops each chunk's leading run of its predecessor's last key.
+ *
+ * The sorted array feeds any layout; layout::veb_layout_t also builds on several threads:
+ * @code
+ * std::vector<uint64_t> keys = jrmwng::algorithm::bulk::load<uint64_t>("keys.bin", { .dedupe = true });
+ * jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb(keys, 0); // 0: one thread per core
+ * @endcode
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace bulk
+        {
+            struct bulk_options
+            {
+                size_t threads = 0;     // 0 for std::thread::hardware_concurrency().
+                bool dedupe = false;    // Keep one of each run of equivalent keys.
+            };
+
+            namespace details
+            {
+                constexpr unsigned bucket_bits_v = 11;
+
+                template <typename T>
+                constexpr bool is_radix_key_v = requires(T const t) { keys::normalize(t); };
+
+                inline size_t thread_count(size_t const uThreads, size_t const uSize)
+                {
+                    size_t const uWanted = uThreads ? uThreads : std::max<size_t>(1, std::thread::hardware_concurrency());
+                    // Below 64K keys per thread, starting threads costs more than it saves.
+                    return std::max<size_t>(1, std::min(uWanted, uSize / 65536));
+                }
+
+                using parallel::parallel_for;
+
+                /**
+                 * @brief The first element of thread t's share when uSize elements are split among uThreads.
+                 */
+                inline size_t chunk_begin(size_t const uSize, size_t const uThreads, size_t const t)
+                {
+                    return uSize / uThreads * t + std::min(t, uSize % uThreads);
+                }
+
+                /**
+                 * @brief Sorts a bucket by the low uBits bits of its normalized offsets, with one stable pass per varying byte.
+                 *
+                 * @param spanFrom The bucket; holds the result on return.
+                 * @param spanTemp Scratch space of the same size.
+                 */
+                template <typename T, typename U>
+                void lsd_sort(std::span<T> spanFrom, std::span<T> spanTemp, U const uMin, unsigned const uBits)
+                {
+                    if (spanFrom.size() < 64)
+                    {
+                        std::sort(spanFrom.begin(), spanFrom.end(), [](T const & a, T const & b) { return keys::normalize(a) < keys::normalize(b); });
+                        return;
+                    }
+                    std::span<T> spanSource = spanFrom;
+                    std::span<T> spanTarget = spanTemp;
+                    for (unsigned uShift = 0; uShift < uBits; uShift += 8)
+                    {
+                        std::array<size_t, 256> aCount{};
+                        for (T const & t : spanSource)
+                        {
+                            ++aCount[static_cast<size_t>((keys::normalize(t) - uMin) >> uShift) & 0xFF];
+                        }
+                        if (std::find(aCount.begin(), aCount.end(), spanSource.size()) != aCount.end())
+                        {
+                            continue;   // Every key has the same byte here.
+                        }
+                        size_t uOffset = 0;
+                        for (size_t & uCount : aCount)
+                        {
+                            uOffset += std::exchange(uCount, uOffset);
+                        }
+                        for (T const & t : spanSource)
+                        {
+                            spanTarget[aCount[static_cast<size_t>((keys::normalize(t) - uMin) >> uShift) & 0xFF]++] = t;
+                        }
+                        std::swap(spanSource, spanTarget);
+                    }
+                    if (spanSource.data() != spanFrom.data())
+                    {
+                        std::copy(spanSource.begin(), spanSource.end(), spanFrom.begin());
+                    }
+                }
+
+                /**
+                 * @brief Radix sorts keys supported by keys::normalize on uThreads threads.
+                 */
+                template <typename T>
+                void radix_sort(std::span<T> data, size_t const uThreads)
+                {
+                    using normalized_type = keys::normalized_t<T>;
+                    constexpr size_t buckets_v = size_t(1) << bucket_bits_v;
+
+                    std::vector<normalized_type> vecMin(uThreads, std::numeric_limits<normalized_type>::max());
+                    std::vector<normalized_type> vecMax(uThreads, 0);
+                    parallel_for(uThreads, [&](size_t const t)
+                    {
+                        for (size_t i = chunk_begin(data.size(), uThreads, t); i < chunk_begin(data.size(), uThreads, t + 1); ++i)
+                        {
+                            vecMin[t] = std::min(vecMin[t], keys::normalize(data[i]));
+                            vecMax[t] = std::max(vecMax[t], keys::normalize(data[i]));
+                        }
+                    });
+                    normalized_type const uMin = *std::min_element(vecMin.begin(), vecMin.end());
+                    normalized_type const uRange = *std::max_element(vecMax.begin(), vecMax.end()) - uMin;
+                    unsigned const uLowBits = std::bit_width(uRange) > bucket_bits_v ? static_cast<unsigned>(std::bit_width(uRange) - bucket_bits_v) : 0;
+                    auto const fnBucket = [=](T const & t)
+                    {
+                        return static_cast<size_t>((keys::normalize(t) - uMin) >> uLowBits);
+                    };
+
+                    // Histogram each thread's share, then give every (bucket, thread) pair its own slice of the buffer.
+                    std::vector<size_t> vecOffset(uThreads * buckets_v, 0);
+                    parallel_for(uThreads, [&](size_t const t)
+                    {
+                        size_t * const pCount = vecOffset.data() + t * buckets_v;
+                        for (size_t i = chunk_begin(data.size(), uThreads, t); i < chunk_begin(data.size(), uThreads, t + 1); ++i)
+                        {
+                            ++pCount[fnBucket(data[i])];
+                        }
+                    });
+                    std::vector<size_t> vecBucket(buckets_v + 1, 0);
+                    size_t uOffset = 0;
+                    for (size_t b = 0; b < buckets_v; ++b)
+                    {
+                        vecBucket[b] = uOffset;
+                        for (size_t t = 0; t < uThreads; ++t)
+                        {
+                            uOffset += std::exchange(vecOffset[t * buckets_v + b], uOffset);
+                        }
+                    }
+                    vecBucket[buckets_v] = uOffset;
+
+                    std::vector<T> vecBuffer(data.size());
+                    parallel_for(uThreads, [&](size_t const t)
+                    {
+                        size_t * const pOffset = vecOffset.data() + t * buckets_v;
+                        for (size_t i = chunk_begin(data.size(), uThreads, t); i < chunk_begin(data.size(), uThreads, t + 1); ++i)
+                        {
+                            vecBuffer[pOffset[fnBucket(data[i])]++] = data[i];
+                        }
+                    });
+
+                    // Sort the buckets back into data, largest first so the last ones taken are short.
+                    std::vector<size_t> vecOrder(buckets_v);
+                    std::iota(vecOrder.begin(), vecOrder.end(), size_t(0));
+                    std::sort(vecOrder.begin(), vecOrder.end(), [&](size_t const a, size_t const b)
+                    {
+                        return vecBucket[a + 1] - vecBucket[a] > vecBucket[b + 1] - vecBucket[b];
+                    });
+                    std::atomic<size_t> uNext = 0;
+                    parallel_for(uThreads, [&](size_t)
+                    {
+                        for (size_t i; (i = uNext.fetch_add(1, std::memory_order_relaxed)) < buckets_v && vecBucket[vecOrder[i] + 1] > vecBucket[vecOrder[i]];)
+                        {
+                            size_t const b = vecOrder[i];
+                            std::span<T> const spanBucket(vecBuffer.data() + vecBucket[b], vecBucket[b + 1] - vecBucket[b]);
+                            std::span<T> const spanTarget = data.subspan(vecBucket[b], spanBucket.size());
+                            lsd_sort(spanBucket, spanTarget, uMin, uLowBits);
+                            std::copy(spanBucket.begin(), spanBucket.end(), spanTarget.begin());
+                        }
+                    });
+                }
+
+                /**
+                 * @brief Sorts per-thread chunks, then merges neighbouring runs pairwise, the merges of a round in parallel.
+                 */
+                template <typename T, typename Compare>
+                void merge_sort(std::span<T> data, size_t const uThreads, Compare const & comp)
+                {
+                    std::vector<size_t> vecRun(uThreads + 1);
+                    for (size_t t = 0; t <= uThreads; ++t)
+                    {
+                        vecRun[t] = chunk_begin(data.size(), uThreads, t);
+                    }
+                    parallel_for(uThreads, [&](size_t const t)
+                    {
+                        std::sort(data.begin() + vecRun[t], data.begin() + vecRun[t + 1], comp);
+                    });
+
+                    std::vector<T> vecBuffer(data.size());
+                    std::span<T> spanSource = data;
+                    std::span<T> spanTarget = vecBuffer;
+                    while (vecRun.size() > 2)
+                    {
+                        // Run pairs merge into one; an odd last run is copied across.
+                        size_t const uRuns = vecRun.size() - 1;
+                        parallel_for((uRuns + 1) / 2, [&](size_t const m)
+                        {
+                            size_t const uFirst = vecRun[2 * m];
+                            size_t const uMiddle = vecRun[std::min(2 * m + 1, uRuns)];
+                            size_t const uLast = vecRun[std::min(2 * m + 2, uRuns)];
+                            std::merge(spanSource.begin() + uFirst, spanSource.begin() + uMiddle, spanSource.begin() + uMiddle, spanSource.begin() + uLast,
+                                spanTarget.begin() + uFirst, comp);
+                        });
+                        std::vector<size_t> vecMerged;
+                        for (size_t r = 0; r < uRuns; r += 2)
+                        {
+                            vecMerged.push_back(vecRun[r]);
+                        }
+                        vecMerged.push_back(vecRun[uRuns]);
+                        vecRun = std::move(vecMerged);
+                        std::swap(spanSource, spanTarget);
+                    }
+                    if (spanSource.data() != data.data())
+                    {
+                        std::copy(spanSource.begin(), spanSource.end(), data.begin());
+                    }
+                }
+            }
+
+            /**
+             * @brief Sorts keys in parallel: radix sort for keys supported by keys::normalize under std::less, merge sort otherwise.
+             *
+             * @param data The keys to sort in place.
+             * @param uThreads The number of threads; 0 for std::thread::hardware_concurrency().
+             * @param comp The order.
+             */
+            template <typename T, typename Compare = std::less<T>>
+            void sort(std::span<T> data, size_t const uThreads = 0, Compare comp = {})
+            {
+                size_t const uUsed = details::thread_count(uThreads, data.size());
+                if constexpr (details::is_radix_key_v<T> && std::is_same_v<Compare, std::less<T>>)
+                {
+                    if (data.size() > 1)
+                    {
+                        details::radix_sort(data, uUsed);
+                    }
+                }
+                else
+                {
+                    details::merge_sort(data, uUsed, comp);
+                }
+            }
+
+            /**
+             * @brief Removes all but the first of each run of equivalent keys from a sorted array, in parallel.
+             *
+             * @param data The sorted keys; the unique keys are moved to its front.
+             * @param uThreads The number of threads; 0 for std::thread::hardware_concurrency().
+             * @param comp The order the keys are sorted by.
+             * @return size_t The number of unique keys.
+             */
+            template <typename T, typename Compare = std::less<T>>
+            size_t unique(std::span<T> data, size_t const uThreads = 0, Compare comp = {})
+            {
+                size_t const uUsed = details::thread_count(uThreads, data.size());
+                auto const fnEquivalent = [&](T const & a, T const & b) { return !comp(a, b) && !comp(b, a); };
+
+                std::vector<size_t> vecBegin(uUsed + 1);   // The chunk bounds; read only inside the parallel section.
+                std::vector<size_t> vecFirst(uUsed);        // Each chunk's first key not equivalent to its predecessor.
+                std::vector<size_t> vecEnd(uUsed);
+                for (size_t t = 0; t <= uUsed; ++t)
+                {
+                    vecBegin[t] = details::chunk_begin(data.size(), uUsed, t);
+                }
+                // Each chunk's predecessor key, read before any chunk is rearranged.
+                std::vector<T> vecPrevious;
+                for (size_t t = 1; t < uUsed; ++t)
+                {
+                    vecPrevious.push_back(data[vecBegin[t] - 1]);
+                }
+                details::parallel_for(uUsed, [&](size_t const t)
+                {
+                    auto itFirst = data.begin() + vecBegin[t];
+                    auto const itLast = data.begin() + vecBegin[t + 1];
+                    while (t > 0 && itFirst != itLast && fnEquivalent(vecPrevious[t - 1], *itFirst))
+                    {
+                        ++itFirst;
+                    }
+                    auto const itEnd = std::unique(itFirst, itLast, fnEquivalent);
+                    vecFirst[t] = static_cast<size_t>(itFirst - data.begin());
+                    vecEnd[t] = static_cast<size_t>(itEnd - data.begin());
+                });
+                // Compact the chunks in order; each moves left, over keys already consumed.
+                size_t uSize = 0;
+                for (size_t t = 0; t < uUsed; ++t)
+                {
+                    std::copy(data.begin() + vecFirst[t], data.begin() + vecEnd[t], data.begin() + uSize);
+                    uSize += vecEnd[t] - vecFirst[t];
+                }
+                return uSize;
+            }
+
+            /**
+             * @brief Copies unsorted keys into a new array, sorted and optionally deduplicated, in parallel.
+             *
+             * @param input The unsorted keys.
+             * @param options The threads and whether to deduplicate.
+             * @return std::vector<T> The search-ready keys.
+             */
+            template <typename T>
+            std::vector<T> load(std::span<T const> input, bulk_options const & options = {})
+            {
+                std::vector<T> vecKey(input.size());
+                size_t const uThreads = details::thread_count(options.threads, input.size());
+                details::parallel_for(uThreads, [&](size_t const t)
+                {
+                    size_t const uFirst = details::chunk_begin(input.size(), uThreads, t);
+                    size_t const uLast = details::chunk_begin(input.size(), uThreads, t + 1);
+                    std::copy(input.begin() + uFirst, input.begin() + uLast, vecKey.begin() + uFirst);
+                });
+                bulk::sort(std::span<T>(vecKey), options.threads);
+                if (options.dedupe)
+                {
+                    vecKey.resize(bulk::unique(std::span<T>(vecKey), options.threads));
+                }
+                return vecKey;
+            }
+
+            /**
+             * @brief Reads unsorted keys from a file of raw, native-endian keys, each thread reading its share, then sorts them.
+             *
+             * @param path The file; its size must be a multiple of sizeof(T).
+             * @param options The threads and whether to deduplicate.
+             * @return std::vector<T> The search-ready keys.
+             */
+            template <typename T>
+            std::vector<T> load(std::filesystem::path const & path, bulk_options const & options = {})
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Keys must be trivially copyable");
+
+                uintmax_t const uBytes = std::filesystem::file_size(path);
+                if (uBytes % sizeof(T) != 0)
+                {
+                    throw std::runtime_error("bulk::load: the file size is not a multiple of the key size");
+                }
+                std::vector<T> vecKey(static_cast<size_t>(uBytes / sizeof(T)));
+                size_t const uThreads = details::thread_count(options.threads, vecKey.size());
+                std::atomic<bool> bFailed = false;
+                details::parallel_for(uThreads, [&](size_t const t)
+                {
+                    size_t const uFirst = details::chunk_begin(vecKey.size(), uThreads, t);
+                    size_t const uLast = details::chunk_begin(vecKey.size(), uThreads, t + 1);
+                    std::ifstream ifs(path, std::ios::binary);
+                    ifs.seekg(static_cast<std::streamoff>(uFirst * sizeof(T)));
+                    if (!ifs.read(reinterpret_cast<char *>(vecKey.data() + uFirst), static_cast<std::streamsize>((uLast - uFirst) * sizeof(T))))
+                    {
+                        bFailed = true;
+                    }
+                });
+                if (bFailed)
+                {
+                    throw std::runtime_error("bulk::load: cannot read " + path.string());
+                }
+                bulk::sort(std::span<T>(vecKey), options.threads);
+                if (options.dedupe)
+                {
+                    vecKey.resize(bulk::unique(std::span<T>(vecKey), options.threads));
+                }
+                return vecKey;
+            }
+        }
+    }
+}
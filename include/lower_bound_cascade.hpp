@@ -0,0 +1,225 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+
+#include <span>             // for std::span
+#include <vector>           // for std::vector
+#include <memory>           // for std::allocator, std::allocator_traits
+#include <ranges>           // for std::ranges::input_range, std::ranges::range_value_t
+#include <algorithm>        // for std::min
+#include <functional>       // for std::less
+#include <stdexcept>        // for std::invalid_argument
+
+/**
+ * @file lower_bound_cascade.hpp
+ * @brief Provides fractional cascading over a list of sorted runs, finding a value's lower bound in every run at once.
+ *
+ * Run i is merged with every p-th element of the augmented run i + 1 into the augmented run i; the last augmented run is
+ * the last run itself. Every element of an augmented run records its lower bound in its own run and, as a bridge, its lower
+ * bound in the next augmented run. A query performs one simd::lower_bound in the first augmented run, then at each later run
+ * follows the bridge and scans at most p - 1 elements before it: every p-th element of that run was merged into the
+ * previous one, so the lower bound cannot lie further back. A query over k runs of n elements costs O(log n + k p) instead
+ * of O(k log n); the augmented runs hold at most p / (p - 1) times the elements of the runs.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace layout
+        {
+            /**
+             * @brief The default sampling step p: every p-th element of a run is copied into the run before it.
+             */
+            constexpr size_t cascade_sample_v = 4;
+
+            /**
+             * @brief Sorted runs linked by fractional cascading.
+             *
+             * @tparam T The type of the keys.
+             * @tparam Compare The ordering of the runs.
+             * @tparam Allocator The allocator of the keys of the first run; the augmented runs use it rebound to their nodes.
+             *
+             * @example
+             * std::vector<std::vector<int>> runs = {{1, 5, 9}, {2, 3, 5, 7}, {4, 8}};
+             * jrmwng::algorithm::layout::cascade_t<int> cascade(runs);
+             * std::vector<size_t> pos(cascade.runs());
+             * cascade.lower_bound(5, pos); // {1, 2, 1}
+             */
+            template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+            class cascade_t
+            {
+                /**
+                 * @brief An element of an augmented run with its lower bounds in its own run and in the next augmented run.
+                 *
+                 * Keeping the links beside the key puts the bounded scan and the link it lands on in the same cache lines.
+                 */
+                struct node_t
+                {
+                    T key;
+                    size_t own;
+                    size_t bridge;
+                };
+
+                using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node_t>;
+
+                std::vector<T, Allocator> m_vecFirst;       // The keys of the first augmented run, for simd::lower_bound.
+                std::vector<std::vector<node_t, node_allocator_type>> m_vecNode; // The augmented runs, each followed by a node for its end.
+                std::vector<size_t> m_vecSize;              // The sizes of the runs.
+                size_t m_uSample;
+                Compare m_comp;
+
+            public:
+                /**
+                 * @brief Links a list of sorted runs.
+                 *
+                 * @param runs The sorted runs, e.g. a std::vector<std::vector<T>> or a list of spans.
+                 * @param uSample The sampling step p, at least 2.
+                 * @param allocator The allocator of the keys of the first run.
+                 */
+                template <typename Runs>
+                requires std::ranges::input_range<Runs>
+                explicit cascade_t(Runs const & runs, size_t const uSample = cascade_sample_v, Compare comp = {}, Allocator const & allocator = Allocator())
+                    : m_vecFirst(allocator)
+                    , m_uSample(uSample)
+                    , m_comp(comp)
+                {
+                    if (m_uSample < 2)
+                    {
+                        throw std::invalid_argument("cascade_t: the sampling step must be at least 2");
+                    }
+                    std::vector<std::span<T const>> vecRun;
+                    for (auto const & run : runs)
+                    {
+                        vecRun.emplace_back(std::ranges::data(run), std::ranges::size(run));
+                        m_vecSize.push_back(vecRun.back().size());
+                    }
+                    m_vecNode.resize(vecRun.size(), std::vector<node_t, node_allocator_type>(node_allocator_type(allocator)));
+
+                    // Build from the last run backwards, merging each run with the samples of the augmented run after it.
+                    for (size_t i = vecRun.size(); i-- > 0;)
+                    {
+                        std::span<T const> const spanRun = vecRun[i];
+                        // The next augmented run and its samples; its end node is not an element.
+                        std::span<node_t const> const spanNext = (i + 1 < vecRun.size())
+                            ? std::span<node_t const>(m_vecNode[i + 1].data(), m_vecNode[i + 1].size() - 1) : std::span<node_t const>();
+                        std::vector<T> vecSample;
+                        for (size_t j = 0; j < spanNext.size(); j += m_uSample)
+                        {
+                            vecSample.push_back(spanNext[j].key);
+                        }
+
+                        std::vector<node_t, node_allocator_type> & vecNode = m_vecNode[i];
+                        vecNode.reserve(spanRun.size() + vecSample.size() + 1);
+                        size_t uRun = 0;
+                        size_t uSample = 0;
+                        size_t uOwn = 0;
+                        size_t uBridge = 0;
+                        while (uRun < spanRun.size() || uSample < vecSample.size())
+                        {
+                            bool const bFromRun = uSample == vecSample.size() || (uRun < spanRun.size() && !m_comp(vecSample[uSample], spanRun[uRun]));
+                            T const & tKey = bFromRun ? spanRun[uRun] : vecSample[uSample];
+                            // The lower bound cursors only move forward, as the merged keys ascend.
+                            while (uOwn < spanRun.size() && m_comp(spanRun[uOwn], tKey))
+                            {
+                                ++uOwn;
+                            }
+                            while (uBridge < spanNext.size() && m_comp(spanNext[uBridge].key, tKey))
+                            {
+                                ++uBridge;
+                            }
+                            vecNode.push_back(node_t{ tKey, uOwn, uBridge });
+                            bFromRun ? ++uRun : ++uSample;
+                        }
+                        vecNode.push_back(node_t{ T{}, spanRun.size(), spanNext.size() });
+                    }
+                    if (!m_vecNode.empty())
+                    {
+                        for (size_t j = 0; j + 1 < m_vecNode[0].size(); ++j)
+                        {
+                            m_vecFirst.push_back(m_vecNode[0][j].key);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Returns the number of runs.
+                 */
+                size_t runs() const
+                {
+                    return m_vecSize.size();
+                }
+
+                /**
+                 * @brief Returns the number of elements in the augmented runs, i.e. the runs plus their samples.
+                 */
+                size_t augmented_size() const
+                {
+                    size_t uSize = 0;
+                    for (std::vector<node_t, node_allocator_type> const & vecNode : m_vecNode)
+                    {
+                        uSize += vecNode.size() - 1;
+                    }
+                    return uSize;
+                }
+
+                /**
+                 * @brief Returns the bytes held by the augmented runs and their links.
+                 */
+                size_t bytes() const
+                {
+                    return (augmented_size() + runs()) * sizeof(node_t) + m_vecFirst.size() * sizeof(T);
+                }
+
+                /**
+                 * @brief Finds the lower bound of a value in every run.
+                 *
+                 * @param value The value to search for.
+                 * @param out Receives, for each run, the position of its first element not less than the value.
+                 */
+                void lower_bound(T const & value, std::span<size_t> const out) const
+                {
+                    if (out.size() < runs())
+                    {
+                        throw std::invalid_argument("cascade_t: the output is shorter than the number of runs");
+                    }
+                    if (runs() == 0)
+                    {
+                        return;
+                    }
+                    size_t uPos = static_cast<size_t>(simd::lower_bound(m_vecFirst, value, m_comp) - m_vecFirst.begin());
+                    for (size_t i = 0;; ++i)
+                    {
+                        node_t const & node = m_vecNode[i][uPos];
+                        out[i] = node.own;
+                        if (i + 1 == runs())
+                        {
+                            break;
+                        }
+                        // The lower bound in the next augmented run lies in (bridge - p, bridge].
+                        node_t const * const pNext = m_vecNode[i + 1].data();
+                        size_t const uFirst = node.bridge - std::min(node.bridge, m_uSample - 1);
+                        uPos = uFirst;
+                        for (size_t j = uFirst; j < node.bridge; ++j)
+                        {
+                            uPos += m_comp(pNext[j].key, value);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Finds the lower bound of a value in every run.
+                 */
+                std::vector<size_t> lower_bound(T const & value) const
+                {
+                    std::vector<size_t> vecPos(runs());
+                    lower_bound(value, vecPos);
+                    return vecPos;
+                }
+            };
+
+            template <typename Runs>
+            cascade_t(Runs const &) -> cascade_t<std::ranges::range_value_t<std::ranges::range_value_t<Runs>>>;
+        }
+    }
+}
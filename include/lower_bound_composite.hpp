@@ -0,0 +1,204 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for ranges::lower_bound and simd::details::simd_traits
+
+#include <array>            // for std::array
+#include <span>             // for std::span
+#include <tuple>            // for std::tuple, std::get
+#include <ranges>           // for std::ranges::range_value_t
+#include <utility>          // for std::pair, std::index_sequence, std::make_index_sequence
+
+/**
+ * @file lower_bound_composite.hpp
+ * @brief Provides lexicographic lower_bound over composite keys stored as separate columns (structure of arrays).
+ *
+ * The n-ary search of ranges::lower_bound runs over the rows of the first column. At each level the first column is compared at all partition
+ * points with SIMD; a later column is only loaded when some partition point compared equal on every column before it.
+ * The per-column less-than and equal masks are combined bitwise into the lexicographic less-than mask the engine expects.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace composite
+        {
+            namespace details
+            {
+                /**
+                 * @brief Checks whether a column type has SIMD compares.
+                 */
+                template <typename T>
+                constexpr bool is_simd_column_v = requires { typename simd::details::simd_traits<T>::simd_type; };
+
+                /**
+                 * @brief Checks whether a fan-out splits into whole SIMD registers of a column type.
+                 */
+                template <typename T, size_t zuFANOUT>
+                constexpr bool is_simd_fanout()
+                {
+                    if constexpr (is_simd_column_v<T>)
+                    {
+                        return zuFANOUT % simd::details::simd_traits<T>::simd_size_v == 0;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+
+                /**
+                 * @brief Loads the column entries at one register's worth of partition points.
+                 */
+                template <typename T, size_t... zuLANE_i>
+                typename simd::details::simd_traits<T>::simd_type gather_column(std::span<T const> const & column, size_t const * const pIndex, std::index_sequence<zuLANE_i...>)
+                {
+                    return simd::details::simd_traits<T>::setr(column[pIndex[zuLANE_i]]...);
+                }
+
+                /**
+                 * @brief Compares a column at partition points against a value.
+                 *
+                 * @return std::pair<int, int> The less-than mask and the equal mask, one bit per partition point.
+                 */
+                template <typename T, size_t zuFANOUT>
+                std::pair<int, int> compare_column(std::span<T const> const & column, std::array<size_t, zuFANOUT> const & aIndex, T const & tValue)
+                {
+                    if constexpr (is_simd_fanout<T, zuFANOUT>())
+                    {
+                        using traits_type = simd::details::simd_traits<T>;
+                        constexpr size_t simd_size_v = traits_type::simd_size_v;
+
+                        auto const simdValue = traits_type::set1(tValue);
+                        int nLess = 0;
+                        int nEqual = 0;
+                        for (size_t uChunk = 0; uChunk < zuFANOUT; uChunk += simd_size_v)
+                        {
+                            auto const simdColumn = gather_column(column, aIndex.data() + uChunk, std::make_index_sequence<simd_size_v>{});
+                            nLess |= traits_type::cmp_lt(simdColumn, simdValue) << uChunk;
+                            nEqual |= traits_type::cmp_eq(simdColumn, simdValue) << uChunk;
+                        }
+                        return { nLess, nEqual };
+                    }
+                    else
+                    {
+                        int nLess = 0;
+                        int nEqual = 0;
+                        for (size_t i = 0; i < zuFANOUT; ++i)
+                        {
+                            T const & tColumn = column[aIndex[i]];
+                            nLess |= (tColumn < tValue) ? (1 << i) : 0;
+                            nEqual |= (!(tValue < tColumn) && !(tColumn < tValue)) ? (1 << i) : 0;
+                        }
+                        return { nLess, nEqual };
+                    }
+                }
+
+                /**
+                 * @brief Projection from the partition points, which are elements of the first column, to their row positions.
+                 */
+                template <typename T0>
+                struct position_projection_t
+                {
+                    T0 const * base;
+
+                    template <typename... Telement>
+                    std::array<size_t, sizeof...(Telement)> operator()(Telement const &... tElement) const
+                    {
+                        return { static_cast<size_t>(&tElement - base)... };
+                    }
+                };
+
+                /**
+                 * @brief Lexicographic less-than over columns, returning one bit per partition point.
+                 */
+                template <typename... Ts>
+                struct composite_compare_t
+                {
+                    std::tuple<std::span<Ts const>...> const & columns;
+
+                    template <size_t zuFANOUT>
+                    int operator()(std::array<size_t, zuFANOUT> const & aIndex, std::tuple<Ts...> const & tupleValue) const
+                    {
+                        return [&]<size_t... zuCOLUMN_i>(std::index_sequence<zuCOLUMN_i...>)
+                        {
+                            int nLess = 0;
+                            int nEqual = (1 << zuFANOUT) - 1;
+                            // Stop at the first column that leaves no partition point tied.
+                            static_cast<void>((... && [&]
+                            {
+                                auto const [nColumnLess, nColumnEqual] = compare_column(std::get<zuCOLUMN_i>(columns), aIndex, std::get<zuCOLUMN_i>(tupleValue));
+                                nLess |= nEqual & nColumnLess;
+                                nEqual &= nColumnEqual;
+                                return nEqual != 0;
+                            }()));
+                            return nLess;
+                        }(std::index_sequence_for<Ts...>{});
+                    }
+                };
+            }
+
+            /**
+             * @brief Sorted composite keys stored as one column per key component.
+             *
+             * @tparam Ts The types of the key components, most significant first.
+             *
+             * @example
+             * std::vector<int> tenant = {1, 1, 2, 2};
+             * std::vector<int64_t> timestamp = {10, 20, 5, 15};
+             * jrmwng::algorithm::composite::columns_t columns(tenant, timestamp);
+             * size_t pos = columns.lower_bound(2, int64_t(10)); // 3
+             */
+            template <typename... Ts>
+            class columns_t
+            {
+                static_assert(sizeof...(Ts) >= 1, "At least one column is required");
+
+                std::tuple<std::span<Ts const>...> m_tupleColumn;
+
+            public:
+                /**
+                 * @brief Refers to the columns, which must have the same length and be sorted lexicographically as rows.
+                 */
+                explicit columns_t(std::span<Ts const>... columns)
+                    : m_tupleColumn(columns...)
+                {
+                }
+
+                size_t size() const
+                {
+                    return std::get<0>(m_tupleColumn).size();
+                }
+
+                /**
+                 * @brief Returns the column of a key component.
+                 */
+                template <size_t zuCOLUMN>
+                auto const & column() const
+                {
+                    return std::get<zuCOLUMN>(m_tupleColumn);
+                }
+
+                /**
+                 * @brief Finds the first row whose key is not lexicographically less than the given key.
+                 *
+                 * @param values The key components.
+                 * @return size_t The row position of the lower bound.
+                 */
+                size_t lower_bound(Ts const &... values) const
+                {
+                    using T0 = std::tuple_element_t<0, std::tuple<Ts...>>;
+                    constexpr size_t fanout_v = details::is_simd_column_v<T0> ? 8 : 1;
+
+                    // The search runs over the first column; the projection maps its elements back to row positions.
+                    std::span<T0 const> const spanRow = std::get<0>(m_tupleColumn);
+                    auto const it = jrmwng::algorithm::ranges::lower_bound(spanRow, std::tuple<Ts...>(values...), details::composite_compare_t<Ts...>{ m_tupleColumn }, details::position_projection_t<T0>{ spanRow.data() }, std::make_index_sequence<fanout_v>{});
+                    return static_cast<size_t>(it - spanRow.begin());
+                }
+            };
+
+            template <typename... Ranges>
+            columns_t(Ranges &&...) -> columns_t<std::ranges::range_value_t<Ranges>...>;
+        }
+    }
+}
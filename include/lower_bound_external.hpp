@@ -0,0 +1,790 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+
+#include <array>            // for std::array
+#include <atomic>           // for std::atomic_ref
+#include <cstddef>          // for std::byte
+#include <cstdint>          // for uint32_t, uint64_t
+#include <cstring>          // for std::memcpy, std::memcmp
+#include <exception>        // for std::exception_ptr, std::make_exception_ptr, std::rethrow_exception
+#include <filesystem>       // for std::filesystem::path
+#include <list>             // for std::list
+#include <memory>           // for std::shared_ptr, std::make_shared_for_overwrite, std::unique_ptr
+#include <ranges>           // for std::ranges::input_range
+#include <span>             // for std::span
+#include <stdexcept>        // for std::runtime_error, std::invalid_argument
+#include <system_error>     // for std::system_error, std::system_category
+#include <type_traits>      // for std::is_trivially_copyable_v, std::is_floating_point_v, std::is_signed_v
+#include <unordered_map>    // for std::unordered_map
+#include <vector>           // for std::vector
+#include <algorithm>        // for std::min, std::max, std::sort, std::fill
+
+#include <cerrno>           // for errno, EINTR
+
+#if defined(__linux__)
+#include <fcntl.h>          // for ::open, O_RDONLY, O_DIRECT
+#include <unistd.h>         // for ::pread, ::pwrite, ::close
+#include <linux/io_uring.h> // for io_uring_params, io_uring_sqe, io_uring_cqe, IORING_OP_READ
+#include <sys/mman.h>       // for ::mmap, ::munmap
+#include <sys/stat.h>       // for ::fstat
+#include <sys/syscall.h>    // for __NR_io_uring_setup, __NR_io_uring_enter
+#endif
+
+/**
+ * @file lower_bound_external.hpp
+ * @brief Provides a static B+tree file format for key sets larger than memory, with a caching, batch-reading reader.
+ *
+ * File layout, in pages of page_size_v bytes:
+ * - page 0: the file header;
+ * - the leaves: the sorted keys, keys_per_page of them per page, so a key's position follows from its page and slot;
+ * - the inner levels bottom-up, the root last: each inner node holds the largest key of each of up to keys_per_page
+ *   consecutive children, so children are found by arithmetic and no pointers are stored.
+ * The reader descends a batch of lookups one level at a time: the pages the level needs that are not in its LRU cache are
+ * read in one batch, through io_uring where the kernel allows it and pread otherwise. A lookup costs at most one read per
+ * level, and the inner levels keep their own share of the cache, so once they fit a lookup reads at most its leaf. Within a
+ * page, the search is simd::lower_bound.
+ *
+ * The file I/O is POSIX with io_uring, so the header declares nothing on platforms other than Linux.
+ */
+
+#if defined(__linux__)
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace external
+        {
+            constexpr size_t page_size_v = 4096;
+
+            namespace details
+            {
+                constexpr size_t max_levels_v = 16;
+                constexpr uint32_t version_v = 1;
+                constexpr char magic_v[8] = { 'J', 'R', 'M', 'W', 'B', 'P', 'T', '\0' };
+
+                /**
+                 * @brief The contents of page 0.
+                 */
+                struct file_header_t
+                {
+                    char magic[8];
+                    uint32_t version;
+                    uint32_t page_size;
+                    uint32_t key_size;
+                    uint32_t key_kind;          // 0 unsigned integer, 1 signed integer, 2 floating point.
+                    uint64_t count;
+                    uint32_t keys_per_page;
+                    uint32_t levels;            // Including the leaves; 0 for an empty file.
+                    uint64_t level_first[max_levels_v]; // First page of each level, the leaves at [0].
+                    uint64_t level_pages[max_levels_v]; // Pages of each level.
+                };
+                static_assert(sizeof(file_header_t) <= page_size_v);
+
+                template <typename T>
+                constexpr uint32_t key_kind_v = std::is_floating_point_v<T> ? 2 : (std::is_signed_v<T> ? 1 : 0);
+
+                struct alignas(page_size_v) page_t
+                {
+                    std::byte bytes[page_size_v];
+                };
+
+                /**
+                 * @brief A page read into a buffer.
+                 */
+                struct read_request_t
+                {
+                    uint64_t page;
+                    page_t * buffer;
+                };
+
+                [[noreturn]] inline void throw_errno(char const * const pszWhat)
+                {
+                    throw std::system_error(errno, std::system_category(), pszWhat);
+                }
+
+                /**
+                 * @brief Checks that the levels of a header describe the tree bulk_load writes for its key count, and that the
+                 * file holds all of their pages.
+                 *
+                 * @param header The header, whose magic, version, page size, level count and key type are already checked.
+                 * @param uKeysPerPage The keys per page of the key type.
+                 * @param uFilePages The number of whole pages in the file.
+                 * @throws std::runtime_error if the header is inconsistent.
+                 */
+                inline void validate_levels(file_header_t const & header, uint64_t const uKeysPerPage, uint64_t const uFilePages)
+                {
+                    if (header.keys_per_page != uKeysPerPage || (header.levels == 0) != (header.count == 0))
+                    {
+                        throw std::runtime_error("external: the header is inconsistent");
+                    }
+                    uint64_t uNextPage = 1;
+                    uint64_t uItems = header.count;
+                    for (uint32_t uLevel = 0; uLevel < header.levels; ++uLevel)
+                    {
+                        // Each level stores its items, keys or children, keys_per_page to a page, right after the level below.
+                        uint64_t const uPages = uItems / uKeysPerPage + (uItems % uKeysPerPage != 0);
+                        bool const bRoot = uLevel + 1 == header.levels;
+                        if (header.level_first[uLevel] != uNextPage || header.level_pages[uLevel] != uPages || (uPages == 1) != bRoot)
+                        {
+                            throw std::runtime_error("external: the header is inconsistent");
+                        }
+                        uNextPage += uPages;
+                        uItems = uPages;
+                    }
+                    if (uNextPage > uFilePages)
+                    {
+                        throw std::runtime_error("external: the file is truncated");
+                    }
+                }
+
+                /**
+                 * @brief Owns a file descriptor.
+                 */
+                class file_t
+                {
+                    int m_fd;
+
+                public:
+                    file_t(std::filesystem::path const & path, int const nFlags, char const * const pszWhat)
+                        : m_fd(::open(path.c_str(), nFlags, 0644))
+                    {
+                        if (m_fd < 0)
+                        {
+                            throw_errno(pszWhat);
+                        }
+                    }
+                    file_t(file_t const &) = delete;
+                    file_t & operator=(file_t const &) = delete;
+                    ~file_t()
+                    {
+                        ::close(m_fd);
+                    }
+
+                    int get() const
+                    {
+                        return m_fd;
+                    }
+                };
+
+                /**
+                 * @brief Writes one whole page, retrying on interruption and short writes.
+                 */
+                inline void pwrite_page(int const fd, uint64_t const uPage, page_t const & page)
+                {
+                    for (size_t uDone = 0; uDone < page_size_v;)
+                    {
+                        ssize_t const nWritten = ::pwrite(fd, page.bytes + uDone, page_size_v - uDone, static_cast<off_t>(uPage * page_size_v + uDone));
+                        if (nWritten < 0 && errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (nWritten <= 0)
+                        {
+                            throw_errno("external: page write failed");
+                        }
+                        uDone += static_cast<size_t>(nWritten);
+                    }
+                }
+
+                /**
+                 * @brief Reads one whole page with pread, retrying on interruption and short reads.
+                 */
+                inline void pread_page(int const fd, read_request_t const & request, size_t uDone = 0)
+                {
+                    while (uDone < page_size_v)
+                    {
+                        ssize_t const nRead = ::pread(fd, request.buffer->bytes + uDone, page_size_v - uDone, static_cast<off_t>(request.page * page_size_v + uDone));
+                        if (nRead < 0 && errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (nRead < 0)
+                        {
+                            throw_errno("external: page read failed");
+                        }
+                        if (nRead == 0)
+                        {
+                            throw std::runtime_error("external: the file is truncated");
+                        }
+                        uDone += static_cast<size_t>(nRead);
+                    }
+                }
+
+                /**
+                 * @brief An LRU cache of pages.
+                 */
+                class page_cache_t
+                {
+                    using page_ptr_t = std::shared_ptr<page_t const>;
+                    using list_type = std::list<std::pair<uint64_t, page_ptr_t>>;
+
+                    size_t m_uCapacity = 0;
+                    list_type m_listLru;
+                    std::unordered_map<uint64_t, typename list_type::iterator> m_mapPage;
+                    size_t m_uHits = 0;
+
+                public:
+                    explicit page_cache_t(size_t const uCapacity = 0)
+                        : m_uCapacity(uCapacity)
+                    {
+                    }
+
+                    size_t hits() const
+                    {
+                        return m_uHits;
+                    }
+
+                    /**
+                     * @brief Returns the cached page, marking it most recently used, or nullptr.
+                     */
+                    page_ptr_t find(uint64_t const uPage)
+                    {
+                        auto const it = m_mapPage.find(uPage);
+                        if (it == m_mapPage.end())
+                        {
+                            return nullptr;
+                        }
+                        m_listLru.splice(m_listLru.begin(), m_listLru, it->second);
+                        ++m_uHits;
+                        return it->second->second;
+                    }
+
+                    void insert(uint64_t const uPage, page_ptr_t pPage)
+                    {
+                        if (m_uCapacity == 0)
+                        {
+                            return;
+                        }
+                        m_listLru.emplace_front(uPage, std::move(pPage));
+                        m_mapPage[uPage] = m_listLru.begin();
+                        if (m_listLru.size() > m_uCapacity)
+                        {
+                            // Pages in use by the current batch stay alive through their shared_ptr.
+                            m_mapPage.erase(m_listLru.back().first);
+                            m_listLru.pop_back();
+                        }
+                    }
+                };
+
+                /**
+                 * @brief A minimal io_uring submitting batches of page reads through the raw system calls.
+                 */
+                class io_uring_t
+                {
+                    int m_fd = -1;
+                    unsigned m_uEntries = 0;
+                    void * m_pSqRing = MAP_FAILED;
+                    void * m_pCqRing = MAP_FAILED;
+                    size_t m_uSqRingBytes = 0;
+                    size_t m_uCqRingBytes = 0;
+                    io_uring_sqe * m_pSqe = static_cast<io_uring_sqe *>(MAP_FAILED);
+                    size_t m_uSqeBytes = 0;
+
+                    unsigned * m_pSqTail = nullptr;
+                    unsigned * m_pSqMask = nullptr;
+                    unsigned * m_pSqArray = nullptr;
+                    unsigned * m_pCqHead = nullptr;
+                    unsigned * m_pCqTail = nullptr;
+                    unsigned * m_pCqMask = nullptr;
+                    io_uring_cqe * m_pCqe = nullptr;
+
+                    static unsigned * field(void * const pRing, uint32_t const uOffset)
+                    {
+                        return reinterpret_cast<unsigned *>(static_cast<char *>(pRing) + uOffset);
+                    }
+
+                public:
+                    /**
+                     * @brief Sets up a ring; valid() is false if the kernel refuses, e.g. when io_uring is disabled.
+                     */
+                    explicit io_uring_t(unsigned const uEntries)
+                    {
+                        io_uring_params params;
+                        std::memset(&params, 0, sizeof(params));
+                        m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, uEntries, &params));
+                        if (m_fd < 0)
+                        {
+                            return;
+                        }
+                        m_uEntries = params.sq_entries;
+                        m_uSqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                        m_uCqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                        if (params.features & IORING_FEAT_SINGLE_MMAP)
+                        {
+                            m_uSqRingBytes = m_uCqRingBytes = std::max(m_uSqRingBytes, m_uCqRingBytes);
+                        }
+                        m_pSqRing = ::mmap(nullptr, m_uSqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+                        m_pCqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? m_pSqRing
+                            : ::mmap(nullptr, m_uCqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+                        m_uSqeBytes = params.sq_entries * sizeof(io_uring_sqe);
+                        m_pSqe = static_cast<io_uring_sqe *>(::mmap(nullptr, m_uSqeBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+                        if (m_pSqRing == MAP_FAILED || m_pCqRing == MAP_FAILED || m_pSqe == MAP_FAILED)
+                        {
+                            reset();
+                            return;
+                        }
+                        m_pSqTail = field(m_pSqRing, params.sq_off.tail);
+                        m_pSqMask = field(m_pSqRing, params.sq_off.ring_mask);
+                        m_pSqArray = field(m_pSqRing, params.sq_off.array);
+                        m_pCqHead = field(m_pCqRing, params.cq_off.head);
+                        m_pCqTail = field(m_pCqRing, params.cq_off.tail);
+                        m_pCqMask = field(m_pCqRing, params.cq_off.ring_mask);
+                        m_pCqe = reinterpret_cast<io_uring_cqe *>(static_cast<char *>(m_pCqRing) + params.cq_off.cqes);
+                    }
+                    io_uring_t(io_uring_t const &) = delete;
+                    io_uring_t & operator=(io_uring_t const &) = delete;
+                    ~io_uring_t()
+                    {
+                        reset();
+                    }
+
+                    void reset()
+                    {
+                        if (m_pSqe != MAP_FAILED)
+                        {
+                            ::munmap(m_pSqe, m_uSqeBytes);
+                            m_pSqe = static_cast<io_uring_sqe *>(MAP_FAILED);
+                        }
+                        if (m_pCqRing != MAP_FAILED && m_pCqRing != m_pSqRing)
+                        {
+                            ::munmap(m_pCqRing, m_uCqRingBytes);
+                        }
+                        m_pCqRing = MAP_FAILED;
+                        if (m_pSqRing != MAP_FAILED)
+                        {
+                            ::munmap(m_pSqRing, m_uSqRingBytes);
+                            m_pSqRing = MAP_FAILED;
+                        }
+                        if (m_fd >= 0)
+                        {
+                            ::close(m_fd);
+                            m_fd = -1;
+                        }
+                    }
+
+                    bool valid() const
+                    {
+                        return m_fd >= 0;
+                    }
+
+                    /**
+                     * @brief Reads every requested page, keeping up to the ring size in flight.
+                     */
+                    void read(int const fd, std::span<read_request_t const> const requests)
+                    {
+                        for (size_t uFirst = 0; uFirst < requests.size(); uFirst += m_uEntries)
+                        {
+                            unsigned const uCount = static_cast<unsigned>(std::min<size_t>(m_uEntries, requests.size() - uFirst));
+
+                            unsigned uTail = std::atomic_ref<unsigned>(*m_pSqTail).load(std::memory_order_relaxed);
+                            for (unsigned i = 0; i < uCount; ++i, ++uTail)
+                            {
+                                read_request_t const & request = requests[uFirst + i];
+                                unsigned const uIndex = uTail & *m_pSqMask;
+                                io_uring_sqe & sqe = m_pSqe[uIndex];
+                                std::memset(&sqe, 0, sizeof(sqe));
+                                sqe.opcode = IORING_OP_READ;
+                                sqe.fd = fd;
+                                sqe.addr = reinterpret_cast<uint64_t>(request.buffer->bytes);
+                                sqe.len = static_cast<uint32_t>(page_size_v);
+                                sqe.off = request.page * page_size_v;
+                                sqe.user_data = uFirst + i;
+                                m_pSqArray[uIndex] = uIndex;
+                            }
+                            std::atomic_ref<unsigned>(*m_pSqTail).store(uTail, std::memory_order_release);
+
+                            // Reap every completion before reporting an error, so that no read is left in flight into a buffer the
+                            // caller is about to free, and the ring starts the next batch empty.
+                            unsigned uSubmit = uCount;      // Entries the kernel has not consumed yet.
+                            unsigned uPending = uCount;     // Completions still to reap.
+                            std::exception_ptr pError;
+                            while (uPending > 0)
+                            {
+                                long const nEnter = ::syscall(__NR_io_uring_enter, m_fd, uSubmit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+                                if (nEnter >= 0)
+                                {
+                                    uSubmit -= std::min(uSubmit, static_cast<unsigned>(nEnter));
+                                }
+                                else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                                {
+                                    if (!pError)
+                                    {
+                                        pError = std::make_exception_ptr(std::system_error(errno, std::system_category(), "external: io_uring_enter failed"));
+                                    }
+                                    if (uSubmit == 0)
+                                    {
+                                        break;  // Waiting itself fails, so nothing more can be reaped.
+                                    }
+                                    // Withdraw the entries the kernel never consumed; they will not complete.
+                                    std::atomic_ref<unsigned>(*m_pSqTail).store(uTail - uSubmit, std::memory_order_release);
+                                    uPending -= uSubmit;
+                                    uSubmit = 0;
+                                }
+
+                                unsigned uHead = std::atomic_ref<unsigned>(*m_pCqHead).load(std::memory_order_relaxed);
+                                unsigned const uCqTail = std::atomic_ref<unsigned>(*m_pCqTail).load(std::memory_order_acquire);
+                                for (; uHead != uCqTail; ++uHead, --uPending)
+                                {
+                                    io_uring_cqe const & cqe = m_pCqe[uHead & *m_pCqMask];
+                                    if (pError)
+                                    {
+                                        continue;
+                                    }
+                                    if (cqe.res < 0)
+                                    {
+                                        pError = std::make_exception_ptr(std::system_error(-cqe.res, std::system_category(), "external: io_uring read failed"));
+                                    }
+                                    else if (static_cast<size_t>(cqe.res) < page_size_v)
+                                    {
+                                        // Finish a short read synchronously.
+                                        try
+                                        {
+                                            pread_page(fd, requests[cqe.user_data], static_cast<size_t>(cqe.res));
+                                        }
+                                        catch (...)
+                                        {
+                                            pError = std::current_exception();
+                                        }
+                                    }
+                                }
+                                std::atomic_ref<unsigned>(*m_pCqHead).store(uHead, std::memory_order_release);
+                            }
+                            if (pError)
+                            {
+                                std::rethrow_exception(pError);
+                            }
+                        }
+                    }
+                };
+            }
+
+            /**
+             * @brief Writes a sorted range as a static B+tree file.
+             *
+             * @tparam Range An input range of sorted, trivially copyable keys. It is read once, a page at a time.
+             * @param path The file to create or overwrite.
+             * @param r The sorted keys.
+             * @return size_t The number of keys written.
+             *
+             * @example
+             * std::vector<uint64_t> keys = ...; // sorted
+             * jrmwng::algorithm::external::bulk_load("keys.bpt", keys);
+             */
+            template <typename Range>
+            requires std::ranges::input_range<Range>
+            size_t bulk_load(std::filesystem::path const & path, Range && r)
+            {
+                using T = std::ranges::range_value_t<Range>;
+                static_assert(std::is_trivially_copyable_v<T>, "Keys must be trivially copyable");
+                constexpr size_t keys_per_page_v = page_size_v / sizeof(T);
+
+                details::file_t const file(path, O_WRONLY | O_CREAT | O_TRUNC, "external: cannot create the file");
+
+                auto const upPage = std::make_unique<details::page_t>();
+                uint64_t uNextPage = 1;
+                auto const fnWritePage = [&](T const * const pKeys, size_t const uKeys)
+                {
+                    std::memset(upPage->bytes, 0, page_size_v);
+                    std::memcpy(upPage->bytes, pKeys, uKeys * sizeof(T));
+                    details::pwrite_page(file.get(), uNextPage++, *upPage);
+                };
+
+                details::file_header_t header;
+                std::memset(&header, 0, sizeof(header));
+                std::memcpy(header.magic, details::magic_v, sizeof(header.magic));
+                header.version = details::version_v;
+                header.page_size = static_cast<uint32_t>(page_size_v);
+                header.key_size = static_cast<uint32_t>(sizeof(T));
+                header.key_kind = details::key_kind_v<T>;
+                header.keys_per_page = static_cast<uint32_t>(keys_per_page_v);
+
+                // Leaves, streamed; remember the largest key of each for the level above.
+                std::vector<T> vecMax;
+                std::vector<T> vecLeaf;
+                vecLeaf.reserve(keys_per_page_v);
+                header.level_first[0] = uNextPage;
+                for (auto const & tKey : r)
+                {
+                    if (header.count && tKey < (vecLeaf.empty() ? vecMax.back() : vecLeaf.back()))
+                    {
+                        throw std::invalid_argument("external: the keys are not sorted");
+                    }
+                    vecLeaf.push_back(tKey);
+                    ++header.count;
+                    if (vecLeaf.size() == keys_per_page_v)
+                    {
+                        fnWritePage(vecLeaf.data(), vecLeaf.size());
+                        vecMax.push_back(vecLeaf.back());
+                        vecLeaf.clear();
+                    }
+                }
+                if (!vecLeaf.empty())
+                {
+                    fnWritePage(vecLeaf.data(), vecLeaf.size());
+                    vecMax.push_back(vecLeaf.back());
+                }
+                header.level_pages[0] = uNextPage - header.level_first[0];
+                header.levels = header.count ? 1 : 0;
+
+                // Inner levels until a single root.
+                while (vecMax.size() > 1)
+                {
+                    if (header.levels == details::max_levels_v)
+                    {
+                        throw std::invalid_argument("external: too many levels");
+                    }
+                    std::vector<T> vecParentMax;
+                    header.level_first[header.levels] = uNextPage;
+                    for (size_t i = 0; i < vecMax.size(); i += keys_per_page_v)
+                    {
+                        size_t const uChildren = std::min(keys_per_page_v, vecMax.size() - i);
+                        fnWritePage(vecMax.data() + i, uChildren);
+                        vecParentMax.push_back(vecMax[i + uChildren - 1]);
+                    }
+                    header.level_pages[header.levels] = uNextPage - header.level_first[header.levels];
+                    ++header.levels;
+                    vecMax = std::move(vecParentMax);
+                }
+
+                // The header goes last, so a file cut short by a failure is rejected by the reader.
+                std::memset(upPage->bytes, 0, page_size_v);
+                std::memcpy(upPage->bytes, &header, sizeof(header));
+                details::pwrite_page(file.get(), 0, *upPage);
+                return static_cast<size_t>(header.count);
+            }
+
+            /**
+             * @brief How the reader issues batched page reads.
+             */
+            enum class io_backend
+            {
+                automatic,  // io_uring if the kernel allows it, else pread.
+                io_uring,   // io_uring; the reader throws if it is unavailable.
+                pread,      // One pread per page.
+            };
+
+            struct reader_options
+            {
+                size_t cache_pages = 1024;          // Pages cached; up to half hold the inner levels, the rest leaves.
+                io_backend backend = io_backend::automatic;
+                unsigned queue_depth = 64;          // io_uring entries, i.e. reads in flight.
+                bool direct_io = false;             // Open with O_DIRECT, bypassing the page cache.
+            };
+
+            /**
+             * @brief Searches a static B+tree file written by bulk_load.
+             *
+             * @tparam T The type of the keys; must match the file.
+             *
+             * @example
+             * jrmwng::algorithm::external::btree_reader_t<uint64_t> reader("keys.bpt");
+             * size_t pos = reader.lower_bound(42);
+             * reader.lower_bound(queries, results); // batched: one read batch per level
+             */
+            template <typename T>
+            class btree_reader_t
+            {
+                using page_ptr_t = std::shared_ptr<details::page_t const>;
+
+                details::file_t m_file;
+                details::file_header_t m_header;
+                std::unique_ptr<details::io_uring_t> m_upRing;
+                details::page_cache_t m_cacheInner;
+                details::page_cache_t m_cacheLeaf;
+                size_t m_uReads = 0;
+
+                details::page_cache_t & cache(uint64_t const uPage)
+                {
+                    return (m_header.levels > 1 && uPage >= m_header.level_first[1]) ? m_cacheInner : m_cacheLeaf;
+                }
+
+                void read(std::span<details::read_request_t const> const requests)
+                {
+                    m_uReads += requests.size();
+                    if (m_upRing)
+                    {
+                        m_upRing->read(m_file.get(), requests);
+                        return;
+                    }
+                    for (details::read_request_t const & request : requests)
+                    {
+                        details::pread_page(m_file.get(), request);
+                    }
+                }
+
+                /**
+                 * @brief Returns the number of keys in a node: the keys of a leaf, or the children of an inner node.
+                 */
+                size_t node_keys(uint32_t const uLevel, uint64_t const uNode) const
+                {
+                    uint64_t const uTotal = uLevel ? m_header.level_pages[uLevel - 1] : m_header.count;
+                    return static_cast<size_t>(std::min<uint64_t>(m_header.keys_per_page, uTotal - uNode * m_header.keys_per_page));
+                }
+
+            public:
+                explicit btree_reader_t(std::filesystem::path const & path, reader_options const & options = {})
+                    : m_file(path, O_RDONLY | (options.direct_io ? O_DIRECT : 0), "external: cannot open the file")
+                {
+                    auto const upPage = std::make_unique<details::page_t>();
+                    details::pread_page(m_file.get(), details::read_request_t{ 0, upPage.get() });
+                    std::memcpy(&m_header, upPage->bytes, sizeof(m_header));
+                    if (std::memcmp(m_header.magic, details::magic_v, sizeof(m_header.magic)) != 0 || m_header.version != details::version_v
+                        || m_header.page_size != page_size_v || m_header.levels > details::max_levels_v)
+                    {
+                        throw std::runtime_error("external: not a B+tree file of this version");
+                    }
+                    if (m_header.key_size != sizeof(T) || m_header.key_kind != details::key_kind_v<T>)
+                    {
+                        throw std::runtime_error("external: the file holds a different key type");
+                    }
+                    struct ::stat statFile;
+                    if (::fstat(m_file.get(), &statFile) != 0)
+                    {
+                        details::throw_errno("external: cannot stat the file");
+                    }
+                    details::validate_levels(m_header, page_size_v / sizeof(T), static_cast<uint64_t>(statFile.st_size) / page_size_v);
+                    // Every lookup passes through the inner levels: give them up to half of the cache, so leaf misses do not evict them.
+                    size_t const uInnerPages = (m_header.levels > 1) ? static_cast<size_t>(m_header.level_first[m_header.levels - 1] + 1 - m_header.level_first[1]) : 0;
+                    size_t const uCapacity = std::max<size_t>(2, options.cache_pages);
+                    m_cacheInner = details::page_cache_t(std::min(uInnerPages, uCapacity / 2));
+                    m_cacheLeaf = details::page_cache_t(uCapacity - std::min(uInnerPages, uCapacity / 2));
+                    if (options.backend != io_backend::pread)
+                    {
+                        m_upRing = std::make_unique<details::io_uring_t>(options.queue_depth);
+                        if (!m_upRing->valid())
+                        {
+                            m_upRing.reset();
+                            if (options.backend == io_backend::io_uring)
+                            {
+                                throw std::runtime_error("external: io_uring is unavailable");
+                            }
+                        }
+                    }
+                }
+                btree_reader_t(btree_reader_t const &) = delete;
+                btree_reader_t & operator=(btree_reader_t const &) = delete;
+
+                size_t size() const
+                {
+                    return static_cast<size_t>(m_header.count);
+                }
+
+                /**
+                 * @brief Returns the number of levels, including the leaves.
+                 */
+                size_t height() const
+                {
+                    return m_header.levels;
+                }
+
+                bool uses_io_uring() const
+                {
+                    return static_cast<bool>(m_upRing);
+                }
+
+                /**
+                 * @brief Returns the number of page requests served from the cache.
+                 */
+                size_t cache_hits() const
+                {
+                    return m_cacheInner.hits() + m_cacheLeaf.hits();
+                }
+
+                /**
+                 * @brief Returns the number of pages read from the file.
+                 */
+                size_t page_reads() const
+                {
+                    return m_uReads;
+                }
+
+                /**
+                 * @brief Finds the lower bounds of a batch of values, reading the missing pages of each level in one batch.
+                 *
+                 * @param values The values to search for.
+                 * @param out Receives the position of each value's lower bound among the sorted keys.
+                 */
+                void lower_bound(std::span<T const> const values, std::span<size_t> const out)
+                {
+                    if (out.size() < values.size())
+                    {
+                        throw std::invalid_argument("external: the output is shorter than the values");
+                    }
+                    if (m_header.levels == 0)
+                    {
+                        std::fill(out.begin(), out.begin() + values.size(), size_t(0));
+                        return;
+                    }
+
+                    // The node each lookup is at, as an index within its level.
+                    std::vector<uint64_t> vecNode(values.size(), 0);
+                    std::vector<uint64_t> vecMissing;
+                    std::vector<details::read_request_t> vecRequest;
+                    std::unordered_map<uint64_t, page_ptr_t> mapLevel;
+                    for (uint32_t uLevel = m_header.levels; uLevel-- > 0;)
+                    {
+                        uint64_t const uFirst = m_header.level_first[uLevel];
+
+                        mapLevel.clear();
+                        vecMissing.clear();
+                        for (uint64_t const uNode : vecNode)
+                        {
+                            if (!mapLevel.count(uFirst + uNode))
+                            {
+                                page_ptr_t pPage = cache(uFirst + uNode).find(uFirst + uNode);
+                                if (!pPage)
+                                {
+                                    vecMissing.push_back(uFirst + uNode);
+                                }
+                                mapLevel.emplace(uFirst + uNode, std::move(pPage));
+                            }
+                        }
+
+                        // Read every missing page of the level at once, in file order.
+                        std::sort(vecMissing.begin(), vecMissing.end());
+                        std::vector<std::shared_ptr<details::page_t>> vecBuffer;
+                        vecRequest.clear();
+                        for (uint64_t const uPage : vecMissing)
+                        {
+                            vecBuffer.push_back(std::make_shared_for_overwrite<details::page_t>());
+                            vecRequest.push_back(details::read_request_t{ uPage, vecBuffer.back().get() });
+                        }
+                        read(vecRequest);
+                        for (size_t i = 0; i < vecMissing.size(); ++i)
+                        {
+                            mapLevel[vecMissing[i]] = vecBuffer[i];
+                            cache(vecMissing[i]).insert(vecMissing[i], vecBuffer[i]);
+                        }
+
+                        for (size_t i = 0; i < values.size(); ++i)
+                        {
+                            std::span<T const> const spanKey(reinterpret_cast<T const *>(mapLevel[uFirst + vecNode[i]]->bytes), node_keys(uLevel, vecNode[i]));
+                            size_t const uLess = static_cast<size_t>(simd::lower_bound(spanKey, values[i]) - spanKey.begin());
+                            if (uLevel)
+                            {
+                                // Past every child's largest key: the lower bound is the end of the last child.
+                                vecNode[i] = vecNode[i] * m_header.keys_per_page + std::min(uLess, spanKey.size() - 1);
+                            }
+                            else
+                            {
+                                out[i] = static_cast<size_t>(vecNode[i] * m_header.keys_per_page + uLess);
+                            }
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Finds the position of a value's lower bound among the sorted keys.
+                 */
+                size_t lower_bound(T const & value)
+                {
+                    size_t uResult = 0;
+                    lower_bound(std::span<T const>(&value, 1), std::span<size_t>(&uResult, 1));
+                    return uResult;
+                }
+            };
+        }
+    }
+}
+#endif
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>          // for size_t
+#include <new>              // for std::bad_alloc, std::align_val_t
+#include <vector>           // for std::vector
+#include <limits>           // for std::numeric_limits
+
+#if defined(__linux__)
+#include <sys/mman.h>       // for mmap, munmap, madvise, MAP_HUGETLB, MADV_HUGEPAGE
+#elif defined(_WIN32)
+#include <malloc.h>         // for _aligned_malloc, _aligned_free
+#endif
+
+/**
+ * @file lower_bound_huge_page.hpp
+ * @brief Provides a cache-line-aligned allocator backed by 2MB huge pages for large search arrays.
+ *
+ * Each step of a k-ary search over a large array touches a different 4K page, so almost every step misses the TLB.
+ * Backing the array with 2MB pages lets one TLB entry cover 512 times more keys.
+ * Large allocations are 2MB-aligned and either explicit huge pages (`MAP_HUGETLB`) or transparent huge pages (`madvise(MADV_HUGEPAGE)`),
+ * falling back to regular pages when huge pages are unavailable. Small allocations and non-Linux targets are 64-byte aligned.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace memory
+        {
+            /**
+             * @brief Size of a cache line, the minimum alignment of every allocation.
+             */
+            constexpr size_t cache_line_size_v = 64;
+
+            /**
+             * @brief Size of a huge page. Allocations of at least this size are rounded up to and aligned at it.
+             */
+            constexpr size_t huge_page_size_v = size_t(2) << 20;
+
+            /**
+             * @brief How large allocations are backed by huge pages.
+             */
+            enum class huge_page_policy
+            {
+                transparent,    ///< Regular mapping with `madvise(MADV_HUGEPAGE)`.
+                explicit_pages, ///< `MAP_HUGETLB` from the reserved huge page pool, falling back to `transparent`.
+            };
+
+            namespace details
+            {
+                /**
+                 * @brief Rounds a byte count up to a multiple of an alignment.
+                 */
+                constexpr size_t round_up(size_t const uBytes, size_t const uAlign)
+                {
+                    return (uBytes + (uAlign - 1)) & ~(uAlign - 1);
+                }
+
+                /**
+                 * @brief Allocates 64-byte-aligned storage, huge page backed when large enough.
+                 *
+                 * @param uBytes The number of bytes to allocate.
+                 * @param ePolicy How to back large allocations.
+                 * @return void* The storage. Throws std::bad_alloc on failure.
+                 */
+                inline void * allocate(size_t const uBytes, huge_page_policy const ePolicy)
+                {
+#if defined(__linux__)
+                    if (uBytes >= huge_page_size_v)
+                    {
+                        size_t const uMapped = round_up(uBytes, huge_page_size_v);
+#if defined(MAP_HUGETLB)
+                        if (ePolicy == huge_page_policy::explicit_pages)
+                        {
+                            void * const pHuge = ::mmap(nullptr, uMapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                            if (pHuge != MAP_FAILED)
+                            {
+                                return pHuge;
+                            }
+                        }
+#endif
+                        // Over-map by one huge page so the start can be aligned, then trim the slack on both sides.
+                        void * const pRaw = ::mmap(nullptr, uMapped + huge_page_size_v, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                        if (pRaw == MAP_FAILED)
+                        {
+                            throw std::bad_alloc();
+                        }
+                        char * const pcRaw = static_cast<char *>(pRaw);
+                        char * const pcAligned = reinterpret_cast<char *>(round_up(reinterpret_cast<size_t>(pcRaw), huge_page_size_v));
+                        if (size_t const uHead = static_cast<size_t>(pcAligned - pcRaw))
+                        {
+                            ::munmap(pcRaw, uHead);
+                        }
+                        if (size_t const uTail = huge_page_size_v - static_cast<size_t>(pcAligned - pcRaw))
+                        {
+                            ::munmap(pcAligned + uMapped, uTail);
+                        }
+#if defined(MADV_HUGEPAGE)
+                        ::madvise(pcAligned, uMapped, MADV_HUGEPAGE);
+#endif
+                        return pcAligned;
+                    }
+#endif
+                    static_cast<void>(ePolicy);
+#if defined(_WIN32)
+                    void * const p = ::_aligned_malloc(round_up(uBytes, cache_line_size_v), cache_line_size_v);
+                    if (!p)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    return p;
+#else
+                    return ::operator new(round_up(uBytes, cache_line_size_v), std::align_val_t(cache_line_size_v));
+#endif
+                }
+
+                /**
+                 * @brief Releases storage obtained from allocate with the same byte count.
+                 */
+                inline void deallocate(void * const p, size_t const uBytes)
+                {
+#if defined(__linux__)
+                    if (uBytes >= huge_page_size_v)
+                    {
+                        ::munmap(p, round_up(uBytes, huge_page_size_v));
+                        return;
+                    }
+#endif
+#if defined(_WIN32)
+                    static_cast<void>(uBytes);
+                    ::_aligned_free(p);
+#else
+                    ::operator delete(p, std::align_val_t(cache_line_size_v));
+#endif
+                }
+            }
+
+            /**
+             * @brief Allocator returning 64-byte-aligned storage, backed by 2MB huge pages for allocations of at least 2MB.
+             *
+             * @tparam T The type of the elements.
+             * @tparam ePOLICY How to back large allocations.
+             *
+             * @example
+             * jrmwng::algorithm::memory::huge_page_vector<int> vec(size_t(1) << 30);
+             * auto it = jrmwng::algorithm::simd::lower_bound(vec, 42);
+             */
+            template <typename T, huge_page_policy ePOLICY = huge_page_policy::transparent>
+            struct huge_page_allocator
+            {
+                using value_type = T;
+
+                template <typename U>
+                struct rebind
+                {
+                    using other = huge_page_allocator<U, ePOLICY>;
+                };
+
+                huge_page_allocator() noexcept = default;
+
+                template <typename U>
+                huge_page_allocator(huge_page_allocator<U, ePOLICY> const &) noexcept
+                {
+                }
+
+                T * allocate(size_t const uCount)
+                {
+                    if (uCount > std::numeric_limits<size_t>::max() / sizeof(T))
+                    {
+                        throw std::bad_alloc();
+                    }
+                    return static_cast<T *>(details::allocate(uCount * sizeof(T), ePOLICY));
+                }
+
+                void deallocate(T * const p, size_t const uCount) noexcept
+                {
+                    details::deallocate(p, uCount * sizeof(T));
+                }
+
+                template <typename U>
+                bool operator==(huge_page_allocator<U, ePOLICY> const &) const noexcept
+                {
+                    return true;
+                }
+            };
+
+            /**
+             * @brief A std::vector whose storage comes from huge_page_allocator.
+             */
+            template <typename T, huge_page_policy ePOLICY = huge_page_policy::transparent>
+            using huge_page_vector = std::vector<T, huge_page_allocator<T, ePOLICY>>;
+        }
+    }
+}
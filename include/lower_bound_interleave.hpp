@@ -0,0 +1,355 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::dispatch_v, simd::details::simd_compare_t and simd::details::simd_projection_t
+
+#include <coroutine>        // for std::coroutine_handle, std::suspend_always
+#include <vector>           // for std::vector
+#include <array>            // for std::array
+#include <memory>           // for std::to_address
+#include <iterator>         // for std::contiguous_iterator
+#include <exception>        // for std::terminate
+#include <utility>          // for std::exchange, std::make_index_sequence
+#include <new>              // for ::operator new, ::operator delete
+#include <algorithm>        // for std::min, std::max
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>      // for _mm_prefetch
+#endif
+
+/**
+ * @file lower_bound_interleave.hpp
+ * @brief Provides coroutine-interleaved lower_bound lookups (AMAC style) that overlap the cache misses of independent searches.
+ *
+ * Each lookup runs the n-ary search loop of ranges::lower_bound as a coroutine: it computes the partition points of the next level,
+ * prefetches them and suspends. A scheduler keeps N lookups in flight and resumes them round-robin, so by the time a lookup is resumed
+ * its partition points have arrived in cache. The lookups may search different arrays with different key types.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace interleave
+        {
+            namespace details
+            {
+                /**
+                 * @brief Thread-local free lists recycling coroutine frames, bucketed by size in cache lines.
+                 *
+                 * The scheduler creates and destroys one frame per lookup, so recycling keeps malloc off the lookup path.
+                 */
+                struct frame_pool_t
+                {
+                    constexpr static size_t granularity_v = 64;
+                    constexpr static size_t bucket_count_v = 16;
+
+                    std::array<std::vector<void *>, bucket_count_v> free_lists;
+
+                    ~frame_pool_t()
+                    {
+                        for (std::vector<void *> & vecFree : free_lists)
+                        {
+                            for (void * p : vecFree)
+                            {
+                                ::operator delete(p);
+                            }
+                        }
+                    }
+
+                    static frame_pool_t & instance()
+                    {
+                        thread_local frame_pool_t t_pool;
+                        return t_pool;
+                    }
+
+                    static size_t bucket(size_t const uBytes)
+                    {
+                        return (uBytes + (granularity_v - 1)) / granularity_v;
+                    }
+
+                    void * allocate(size_t const uBytes)
+                    {
+                        size_t const uBucket = bucket(uBytes);
+                        if (uBucket < bucket_count_v && !free_lists[uBucket].empty())
+                        {
+                            void * const p = free_lists[uBucket].back();
+                            free_lists[uBucket].pop_back();
+                            return p;
+                        }
+                        return ::operator new(uBucket * granularity_v);
+                    }
+
+                    void deallocate(void * const p, size_t const uBytes)
+                    {
+                        size_t const uBucket = bucket(uBytes);
+                        if (uBucket < bucket_count_v)
+                        {
+                            free_lists[uBucket].push_back(p);
+                        }
+                        else
+                        {
+                            ::operator delete(p);
+                        }
+                    }
+                };
+
+                /**
+                 * @brief Prefetches the element an iterator refers to, if the iterator is contiguous.
+                 */
+                template <typename Titerator>
+                void prefetch(Titerator const & it)
+                {
+                    if constexpr (std::contiguous_iterator<Titerator>)
+                    {
+#if defined(__GNUC__) || defined(__clang__)
+                        __builtin_prefetch(std::to_address(it), 0, 3);
+#elif defined(_M_IX86) || defined(_M_X64)
+                        _mm_prefetch(reinterpret_cast<char const *>(std::to_address(it)), _MM_HINT_T0);
+#endif
+                    }
+                }
+            }
+
+            /**
+             * @brief A suspended lower_bound lookup. Resuming it advances the search by one level.
+             */
+            class lookup_task
+            {
+            public:
+                struct promise_type
+                {
+                    size_t result = 0;
+
+                    lookup_task get_return_object()
+                    {
+                        return lookup_task(std::coroutine_handle<promise_type>::from_promise(*this));
+                    }
+                    std::suspend_always initial_suspend() noexcept
+                    {
+                        return {};
+                    }
+                    std::suspend_always final_suspend() noexcept
+                    {
+                        return {};
+                    }
+                    void return_value(size_t const uResult)
+                    {
+                        result = uResult;
+                    }
+                    void unhandled_exception()
+                    {
+                        std::terminate();
+                    }
+                    static void * operator new(size_t const uBytes)
+                    {
+                        return details::frame_pool_t::instance().allocate(uBytes);
+                    }
+                    static void operator delete(void * const p, size_t const uBytes)
+                    {
+                        details::frame_pool_t::instance().deallocate(p, uBytes);
+                    }
+                };
+
+                lookup_task() = default;
+                explicit lookup_task(std::coroutine_handle<promise_type> handle)
+                    : m_handle(handle)
+                {
+                }
+                lookup_task(lookup_task && that) noexcept
+                    : m_handle(std::exchange(that.m_handle, nullptr))
+                {
+                }
+                lookup_task & operator=(lookup_task && that) noexcept
+                {
+                    if (this != &that)
+                    {
+                        reset();
+                        m_handle = std::exchange(that.m_handle, nullptr);
+                    }
+                    return *this;
+                }
+                ~lookup_task()
+                {
+                    reset();
+                }
+
+                explicit operator bool() const
+                {
+                    return static_cast<bool>(m_handle);
+                }
+
+                /**
+                 * @brief Advances the lookup by one level.
+                 *
+                 * @return true if the lookup has finished.
+                 */
+                bool step()
+                {
+                    m_handle.resume();
+                    return m_handle.done();
+                }
+
+                bool done() const
+                {
+                    return m_handle.done();
+                }
+
+                /**
+                 * @brief Returns the position of the lower bound. The lookup must be done.
+                 */
+                size_t result() const
+                {
+                    return m_handle.promise().result;
+                }
+
+                void reset()
+                {
+                    if (m_handle)
+                    {
+                        std::exchange(m_handle, nullptr).destroy();
+                    }
+                }
+
+            private:
+                std::coroutine_handle<promise_type> m_handle;
+            };
+
+            /**
+             * @brief Performs a lower bound search on a range using n-ary search, suspending after prefetching each level.
+             *
+             * @tparam zuFANOUT The number of partition points compared per level.
+             * @param r The range to search. It must outlive the lookup.
+             * @param value The value to search for.
+             * @param comp The comparison function, returning a bitmask as in ranges::lower_bound.
+             * @param proj The projection function.
+             * @return lookup_task The suspended lookup; its result is the position of the lower bound.
+             */
+            template <size_t zuFANOUT, typename Range, typename T, typename Compare, typename Projection>
+            requires std::ranges::random_access_range<Range>
+            lookup_task lower_bound(Range const & r, T value, Compare comp, Projection proj)
+            {
+                using Titerator = std::ranges::iterator_t<Range const>;
+
+                Titerator const itBegin = std::ranges::begin(r);
+                Titerator first = itBegin;
+                Titerator last = std::ranges::end(r);
+
+                while (first < last)
+                {
+                    auto const distance = std::distance(first, last);
+                    std::array<Titerator, zuFANOUT> iters;
+                    for (size_t i = 0; i < zuFANOUT; ++i)
+                    {
+                        iters[i] = first + static_cast<std::iter_difference_t<Titerator>>((1 + i) * distance / (1 + zuFANOUT));
+                        details::prefetch(iters[i]);
+                    }
+
+                    co_await std::suspend_always{};
+
+                    auto const nCompare = [&]<size_t... zuPARTITION_i>(std::index_sequence<zuPARTITION_i...>)
+                    {
+                        return std::invoke(comp, std::invoke(proj, (*iters[zuPARTITION_i])...), value);
+                    }(std::make_index_sequence<zuFANOUT>{});
+
+                    int const nIndex1 = std::popcount((unsigned)nCompare);
+                    if (nIndex1)
+                    {
+                        first = iters[nIndex1 - 1] + 1;
+                    }
+                    if (static_cast<size_t>(nIndex1) < zuFANOUT)
+                    {
+                        last = iters[nIndex1];
+                    }
+                }
+
+                co_return static_cast<size_t>(std::distance(itBegin, first));
+            }
+
+            /**
+             * @brief Creates a lookup with the fan-out simd::lower_bound would pick for the same arguments.
+             *
+             * @param r The range to search. It must outlive the lookup.
+             * @param value The value to search for.
+             * @param comp The comparison function.
+             * @param proj The projection function.
+             * @return lookup_task The suspended lookup.
+             */
+            template <typename Range, typename T, typename Compare = std::less<T>, typename Projection = std::identity>
+            requires std::ranges::random_access_range<Range>
+            lookup_task lower_bound(Range const & r, T const & value, Compare comp = {}, Projection proj = {})
+            {
+                constexpr size_t fanout_v = simd::dispatch_v<Range, T, Compare, Projection>.fanout;
+
+                if constexpr (fanout_v > 1)
+                {
+                    return interleave::lower_bound<fanout_v>(r, value, simd::details::simd_compare_t<Compare, T>{comp}, simd::details::simd_projection_t<Projection>{proj});
+                }
+                else
+                {
+                    return interleave::lower_bound<1>(r, value, comp, proj);
+                }
+            }
+
+            /**
+             * @brief Runs lookups with up to uInFlight of them interleaved, resuming them round-robin.
+             *
+             * @tparam Tfactory Invocable with a lookup index, returning its lookup_task.
+             * @tparam Toutput Random access iterator receiving the result of each lookup, indexed by lookup.
+             * @param uInFlight The number of lookups in flight.
+             * @param uCount The number of lookups.
+             * @param fnMake Creates the lookup with a given index. Called lazily, so only uInFlight frames are alive at a time.
+             * @param itResult Receives the results.
+             *
+             * @example
+             * std::vector<size_t> results(keys.size());
+             * jrmwng::algorithm::interleave::run(16, keys.size(), [&](size_t i) { return jrmwng::algorithm::interleave::lower_bound(vec, keys[i]); }, results.begin());
+             */
+            template <typename Tfactory, typename Toutput>
+            void run(size_t const uInFlight, size_t const uCount, Tfactory fnMake, Toutput itResult)
+            {
+                struct slot_t
+                {
+                    lookup_task task;
+                    size_t index;
+                };
+
+                std::vector<slot_t> vecSlot(std::max<size_t>(1, std::min(uInFlight, uCount)));
+                size_t uNext = 0;
+                size_t uActive = 0;
+
+                // Start each lookup, so its first level is already being prefetched when the round-robin reaches it.
+                auto const fnStart = [&](slot_t & slot)
+                {
+                    while (uNext < uCount)
+                    {
+                        slot.index = uNext;
+                        slot.task = fnMake(uNext++);
+                        if (!slot.task.step())
+                        {
+                            return true;
+                        }
+                        itResult[slot.index] = slot.task.result();
+                    }
+                    slot.task.reset();
+                    return false;
+                };
+
+                for (slot_t & slot : vecSlot)
+                {
+                    uActive += fnStart(slot);
+                }
+                while (uActive)
+                {
+                    for (slot_t & slot : vecSlot)
+                    {
+                        if (slot.task && slot.task.step())
+                        {
+                            itResult[slot.index] = slot.task.result();
+                            uActive -= !fnStart(slot);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
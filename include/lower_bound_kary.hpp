@@ -0,0 +1,255 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::details::simd_compare_t, simd_projection_t and is_lane_projection
+
+#include <array>            // for std::array
+#include <span>             // for std::span, std::dynamic_extent
+#include <bit>              // for std::popcount
+#include <limits>           // for std::numeric_limits
+#include <utility>          // for std::index_sequence, std::make_index_sequence
+#include <algorithm>        // for std::min
+#include <functional>       // for std::less, std::identity, std::invoke
+#include <type_traits>      // for std::is_unsigned_v, std::remove_cvref_t
+#include <ranges>           // for std::ranges::random_access_range, std::ranges::size
+#include <stdexcept>        // for std::invalid_argument
+
+/**
+ * @file lower_bound_kary.hpp
+ * @brief Provides a division-free k-ary search driven by a step schedule precomputed for the size of the range.
+ *
+ * ranges::lower_bound places its K partition points at (1 + i) * distance / (1 + K) on every level, K multiplications and
+ * divisions on the critical path of each step. Here the range is treated as if padded with copies of its last key to
+ * (K + 1)^L - 1 keys, the least such size holding it. The blocks of every level then have the same stride
+ * s = (K + 1)^(L - 1 - l), known before the search starts: level l compares the keys at base + (i + 1) * s - 1, clamped to
+ * the last key, and advances base by s times the number of keys less than the value. A level costs a few adds, a
+ * fixed-stride SIMD compare and a popcount. The padding changes no answer, except that a value greater than every key
+ * lands on the padded size, which is clamped to the real one.
+ *
+ * A kary_schedule_t holds the strides for a size; ranges whose size is part of their type (std::array, fixed-extent
+ * std::span, C arrays) get a constexpr schedule and a fully unrolled search of a compile-time number of levels.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace simd
+        {
+            namespace details
+            {
+                /**
+                 * @brief The size of a range when it is part of its type; std::dynamic_extent otherwise.
+                 */
+                template <typename Range>
+                constexpr size_t static_size_v = std::dynamic_extent;
+                template <typename T, size_t zuSIZE>
+                constexpr size_t static_size_v<std::array<T, zuSIZE>> = zuSIZE;
+                template <typename T, size_t zuSIZE>
+                constexpr size_t static_size_v<std::span<T, zuSIZE>> = zuSIZE;
+                template <typename T, size_t zuSIZE>
+                constexpr size_t static_size_v<T[zuSIZE]> = zuSIZE;
+
+                /**
+                 * @brief Whether count_less compares its K keys in one SIMD compare: K is the width of a SIMD vector of T and the
+                 * keys reach the comparison as T, the rule simd::lower_bound dispatches by.
+                 *
+                 * Unsigned 64-bit keys keep the scalar fold: AVX2 compares them only after flipping their sign bits, and that
+                 * lost to the fold in lower_bound_bench_kary for every range that fits in the cache.
+                 */
+                template <typename Tinput, typename T, typename Projection, size_t zuFANOUT>
+                constexpr bool is_kary_simd_v = []
+                {
+                    if constexpr (is_simd_key_v<T>)
+                    {
+                        if constexpr (zuFANOUT == simd_traits<T>::simd_size_v && !(std::is_unsigned_v<T> && sizeof(T) == 8))
+                        {
+                            return is_lane_projection<Tinput, T, Projection>(std::make_index_sequence<zuFANOUT>{});
+                        }
+                    }
+                    return false;
+                }();
+
+                /**
+                 * @brief Counts the keys less than the value at base + (i + 1) * stride - 1, i < K, each clamped to the last key.
+                 */
+                template <typename Titerator, typename T, typename Compare, typename Projection, size_t... zuPROBE_i>
+                size_t count_less(Titerator const first, size_t const uBase, size_t const uStride, size_t const uLast, T const & value,
+                    Compare const & comp, Projection const & proj, std::index_sequence<zuPROBE_i...>)
+                {
+                    using Tinput = std::remove_cvref_t<decltype(*first)>;
+
+                    if constexpr (is_kary_simd_v<Tinput, T, Projection, sizeof...(zuPROBE_i)>)
+                    {
+                        int const nCompare = simd_compare_t<Compare, T>{ comp }(
+                            simd_projection_t<Projection>{ proj }(first[std::min(uBase + (zuPROBE_i + 1) * uStride - 1, uLast)]...), value);
+                        return static_cast<size_t>(std::popcount(static_cast<unsigned>(nCompare)));
+                    }
+                    else
+                    {
+                        return (size_t(0) + ... + static_cast<size_t>(std::invoke(comp, std::invoke(proj, first[std::min(uBase + (zuPROBE_i + 1) * uStride - 1, uLast)]), value)));
+                    }
+                }
+            }
+
+            /**
+             * @brief The fan-out simd::lower_bound compares per level for keys of type T: one SIMD register of them, or 1.
+             */
+            template <typename T>
+            constexpr size_t kary_fanout_v = []
+            {
+                if constexpr (details::is_simd_key_v<T>)
+                {
+                    return details::simd_traits<T>::simd_size_v;
+                }
+                else
+                {
+                    return size_t(1);
+                }
+            }();
+
+            /**
+             * @brief The strides of a k-ary search over a range of a given size.
+             *
+             * @tparam zuFANOUT The number K of keys compared per level.
+             *
+             * @example
+             * std::vector<float> vec = ...; // sorted
+             * jrmwng::algorithm::simd::kary_schedule_t<8> const schedule(vec.size());
+             * auto it = jrmwng::algorithm::simd::kary_lower_bound(vec, 3.0f, schedule);
+             */
+            template <size_t zuFANOUT>
+            class kary_schedule_t
+            {
+                static_assert(zuFANOUT >= 1 && zuFANOUT <= 32, "The fan-out must be between 1 and 32");
+
+            public:
+                constexpr static size_t fanout_v = zuFANOUT;
+                constexpr static size_t max_levels_v = std::numeric_limits<size_t>::digits;
+
+            private:
+                size_t m_uSize;
+                size_t m_uLevels;
+                std::array<size_t, max_levels_v> m_aStride;
+
+            public:
+                /**
+                 * @brief Computes the strides for a range of uSize keys.
+                 *
+                 * @param uSize The size of the range; (K + 1)^L - 1 must fit in size_t for the least L holding it.
+                 */
+                constexpr explicit kary_schedule_t(size_t const uSize)
+                    : m_uSize(uSize)
+                    , m_uLevels(0)
+                    , m_aStride{}
+                {
+                    // The least L with (K + 1)^L - 1 >= uSize, i.e. (K + 1)^L > uSize.
+                    size_t uBlock = 1;
+                    while (uBlock <= uSize)
+                    {
+                        if (uBlock > std::numeric_limits<size_t>::max() / (zuFANOUT + 1))
+                        {
+                            throw std::invalid_argument("kary_schedule_t: the padded size does not fit in size_t");
+                        }
+                        uBlock *= zuFANOUT + 1;
+                        ++m_uLevels;
+                    }
+                    for (size_t l = 0; l < m_uLevels; ++l)
+                    {
+                        uBlock /= zuFANOUT + 1;
+                        m_aStride[l] = uBlock;
+                    }
+                }
+
+                constexpr size_t size() const
+                {
+                    return m_uSize;
+                }
+
+                /**
+                 * @brief Returns the number L of levels, i.e. of K-key compares per search.
+                 */
+                constexpr size_t levels() const
+                {
+                    return m_uLevels;
+                }
+
+                /**
+                 * @brief Returns the size (K + 1)^L - 1 the range is searched as.
+                 */
+                constexpr size_t padded_size() const
+                {
+                    return m_uLevels ? m_aStride[0] * (zuFANOUT + 1) - 1 : 0;
+                }
+
+                /**
+                 * @brief Returns the distance between the keys compared on level l.
+                 */
+                constexpr size_t stride(size_t const l) const
+                {
+                    return m_aStride[l];
+                }
+            };
+
+            /**
+             * @brief Finds the first position in a sorted range where a given value could be inserted without violating the order,
+             * following a precomputed step schedule.
+             *
+             * @param r The range to search.
+             * @param value The value to compare.
+             * @param schedule The schedule for the size of the range.
+             * @param comp The comparison function.
+             * @param proj The projection function.
+             * @return std::ranges::iterator_t<Range> The iterator pointing to the lower bound.
+             */
+            template <size_t zuFANOUT, typename Range, typename T, typename Compare = std::less<T>, typename Projection = std::identity>
+            requires std::ranges::random_access_range<Range>
+            std::ranges::iterator_t<Range> kary_lower_bound(Range && r, T const & value, kary_schedule_t<zuFANOUT> const & schedule, Compare comp = {}, Projection proj = {})
+            {
+                size_t const uSize = static_cast<size_t>(std::ranges::size(r));
+                if (uSize != schedule.size())
+                {
+                    throw std::invalid_argument("kary_lower_bound: the schedule was computed for another size");
+                }
+                auto const first = std::ranges::begin(r);
+                size_t uBase = 0;
+                for (size_t l = 0; l < schedule.levels(); ++l)
+                {
+                    size_t const uStride = schedule.stride(l);
+                    uBase += uStride * details::count_less(first, uBase, uStride, uSize - 1, value, comp, proj, std::make_index_sequence<zuFANOUT>{});
+                }
+                return first + static_cast<std::ranges::range_difference_t<Range>>(std::min(uBase, uSize));
+            }
+
+            /**
+             * @brief Finds the lower bound in a range whose size is part of its type, with a constexpr schedule and the levels unrolled.
+             *
+             * @tparam zuFANOUT The number K of keys compared per level.
+             * @param r The range to search, e.g. a std::array or a fixed-extent std::span.
+             * @param value The value to compare.
+             * @param comp The comparison function.
+             * @param proj The projection function.
+             * @return std::ranges::iterator_t<Range> The iterator pointing to the lower bound.
+             *
+             * @example
+             * std::array<int, 64> node = ...; // sorted
+             * auto it = jrmwng::algorithm::simd::kary_lower_bound(node, 42); // 2 levels of 8 keys
+             */
+            template <size_t zuFANOUT = 0, typename Range, typename T, typename Compare = std::less<T>, typename Projection = std::identity>
+            requires std::ranges::random_access_range<Range> && (details::static_size_v<std::remove_cvref_t<Range>> != std::dynamic_extent)
+            std::ranges::iterator_t<Range> kary_lower_bound(Range && r, T const & value, Compare comp = {}, Projection proj = {})
+            {
+                constexpr size_t size_v = details::static_size_v<std::remove_cvref_t<Range>>;
+                constexpr size_t fanout_v = zuFANOUT ? zuFANOUT : kary_fanout_v<T>;
+                constexpr kary_schedule_t<fanout_v> schedule_v(size_v);
+
+                auto const first = std::ranges::begin(r);
+                size_t uBase = 0;
+                [&]<size_t... zuLEVEL_i>(std::index_sequence<zuLEVEL_i...>)
+                {
+                    ((uBase += schedule_v.stride(zuLEVEL_i) * details::count_less(first, uBase, schedule_v.stride(zuLEVEL_i), size_v - 1, value, comp, proj, std::make_index_sequence<fanout_v>{})), ...);
+                }(std::make_index_sequence<schedule_v.levels()>{});
+                return first + static_cast<std::ranges::range_difference_t<Range>>(std::min(uBase, size_v));
+            }
+        }
+    }
+}
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+#include "lower_bound_veb.hpp"  // Project-specific header for layout::veb_layout_t and layout::veb_view_t
+
+#include <array>            // for std::array
+#include <bit>              // for std::rotl
+#include <cstddef>          // for std::byte
+#include <cstdint>          // for uint32_t, uint64_t
+#include <cstring>          // for std::memcpy, std::memcmp, std::memset
+#include <filesystem>       // for std::filesystem::path, std::filesystem::rename, std::filesystem::remove
+#include <span>             // for std::span
+#include <stdexcept>        // for std::runtime_error
+#include <system_error>     // for std::system_error, std::system_category
+#include <type_traits>      // for std::is_trivially_copyable_v, std::is_floating_point_v, std::is_signed_v
+#include <utility>          // for std::exchange
+
+#include <cerrno>           // for errno, EINTR
+
+#if defined(__linux__)
+#include <fcntl.h>          // for ::open, O_RDONLY, O_WRONLY, O_CREAT, O_TRUNC
+#include <sys/mman.h>       // for ::mmap, ::munmap, MAP_POPULATE
+#include <sys/stat.h>       // for ::fstat
+#include <unistd.h>         // for ::write, ::fsync, ::close
+#endif
+
+/**
+ * @file lower_bound_mapped.hpp
+ * @brief Provides a binary file format for a sorted key array and its prebuilt search layout, loaded by mmap without copying.
+ *
+ * A file is a header followed by sections, each starting on a page boundary: the keys, then the layout's own arrays. The
+ * header records the format version, the byte order, the key type, the layout kind and, per section, its offset, size and
+ * a 64-bit checksum; the header has a checksum of its own. Loading maps the file and validates the header only, so it takes
+ * constant time apart from page faults; the keys and the layout are spans into the mapping, searched in place. Section
+ * checksums are verified on request, which reads every page. save() writes a temporary file and renames it over the
+ * target, so a process mapping the previous file keeps searching it undisturbed.
+ *
+ * Loading uses mmap with MAP_POPULATE, so the header declares nothing on platforms other than Linux.
+ */
+
+#if defined(__linux__)
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace mapped
+        {
+            /**
+             * @brief The search layout stored alongside the keys.
+             */
+            enum class layout_kind : uint32_t
+            {
+                sorted = 0, // The keys only, searched with simd::lower_bound.
+                veb = 1,    // layout::veb_layout_t nodes.
+            };
+
+            namespace details
+            {
+                constexpr uint32_t version_v = 1;
+                constexpr size_t alignment_v = 4096;
+                constexpr size_t max_sections_v = 4;
+                constexpr uint64_t byte_order_v = 0x0102030405060708ull;
+                constexpr char magic_v[8] = { 'J', 'R', 'M', 'W', 'I', 'D', 'X', '\0' };
+
+                template <typename T>
+                constexpr uint32_t key_kind_v = std::is_floating_point_v<T> ? 2 : (std::is_signed_v<T> ? 1 : 0);
+
+                struct section_t
+                {
+                    uint64_t offset;
+                    uint64_t bytes;
+                    uint64_t checksum;
+                };
+
+                struct file_header_t
+                {
+                    char magic[8];
+                    uint32_t version;
+                    uint32_t header_bytes;
+                    uint64_t byte_order;
+                    uint32_t key_size;
+                    uint32_t key_kind;          // 0 unsigned integer, 1 signed integer, 2 floating point.
+                    uint32_t kind;              // layout_kind.
+                    uint32_t layout_param;      // veb: keys per node.
+                    uint64_t count;
+                    uint32_t sections;
+                    uint32_t reserved;
+                    section_t section[max_sections_v];
+                    uint64_t header_checksum;   // Of every byte above.
+                };
+
+                /**
+                 * @brief A 64-bit checksum over four interleaved lanes of 8-byte words, fast enough to keep up with the disk.
+                 */
+                inline uint64_t checksum(std::span<std::byte const> const bytes)
+                {
+                    constexpr uint64_t prime1_v = 0x9E3779B185EBCA87ull;
+                    constexpr uint64_t prime2_v = 0xC2B2AE3D27D4EB4Full;
+
+                    std::array<uint64_t, 4> aLane = { prime1_v, prime2_v, ~prime1_v, ~prime2_v };
+                    size_t i = 0;
+                    for (; i + sizeof(aLane) <= bytes.size(); i += sizeof(aLane))
+                    {
+                        for (size_t j = 0; j < aLane.size(); ++j)
+                        {
+                            uint64_t uWord;
+                            std::memcpy(&uWord, bytes.data() + i + j * sizeof(uint64_t), sizeof(uWord));
+                            aLane[j] = std::rotl(aLane[j] + uWord * prime2_v, 31) * prime1_v;
+                        }
+                    }
+                    uint64_t uHash = std::rotl(aLane[0], 1) + std::rotl(aLane[1], 7) + std::rotl(aLane[2], 12) + std::rotl(aLane[3], 18) + bytes.size();
+                    for (; i < bytes.size(); ++i)
+                    {
+                        uHash = std::rotl(uHash ^ (static_cast<uint64_t>(bytes[i]) * prime1_v), 11) * prime2_v;
+                    }
+                    uHash ^= uHash >> 33;
+                    uHash *= prime2_v;
+                    uHash ^= uHash >> 29;
+                    return uHash;
+                }
+
+                inline uint64_t header_checksum(file_header_t const & header)
+                {
+                    return checksum(std::span<std::byte const>(reinterpret_cast<std::byte const *>(&header), offsetof(file_header_t, header_checksum)));
+                }
+
+                /**
+                 * @brief Writes a whole buffer, retrying on interruption and short writes; false with errno set on failure.
+                 */
+                inline bool write_all(int const fd, void const * const pData, size_t const uSize)
+                {
+                    for (size_t uDone = 0; uDone < uSize;)
+                    {
+                        ssize_t const nWritten = ::write(fd, static_cast<std::byte const *>(pData) + uDone, uSize - uDone);
+                        if (nWritten < 0 && errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (nWritten <= 0)
+                        {
+                            return false;
+                        }
+                        uDone += static_cast<size_t>(nWritten);
+                    }
+                    return true;
+                }
+
+                /**
+                 * @brief Writes the header and the sections to a temporary file, then renames it over the target.
+                 */
+                template <typename T>
+                void write(std::filesystem::path const & path, layout_kind const kind, uint32_t const uLayoutParam, uint64_t const uCount,
+                    std::span<std::span<std::byte const> const> const sections)
+                {
+                    static_assert(std::is_trivially_copyable_v<T>, "Keys must be trivially copyable");
+
+                    file_header_t header;
+                    std::memset(&header, 0, sizeof(header));
+                    std::memcpy(header.magic, magic_v, sizeof(header.magic));
+                    header.version = version_v;
+                    header.header_bytes = static_cast<uint32_t>(sizeof(header));
+                    header.byte_order = byte_order_v;
+                    header.key_size = static_cast<uint32_t>(sizeof(T));
+                    header.key_kind = key_kind_v<T>;
+                    header.kind = static_cast<uint32_t>(kind);
+                    header.layout_param = uLayoutParam;
+                    header.count = uCount;
+                    header.sections = static_cast<uint32_t>(sections.size());
+
+                    uint64_t uOffset = alignment_v;
+                    for (size_t i = 0; i < sections.size(); ++i)
+                    {
+                        header.section[i] = section_t{ uOffset, sections[i].size(), checksum(sections[i]) };
+                        uOffset += (sections[i].size() + alignment_v - 1) / alignment_v * alignment_v;
+                    }
+                    header.header_checksum = header_checksum(header);
+
+                    // Write and flush the temporary file before the rename publishes it, so a crash leaves the previous file
+                    // or the complete new one, never a torn one; remove the temporary file on any failure.
+                    std::filesystem::path pathTemp = path;
+                    pathTemp += ".tmp";
+                    int const fd = ::open(pathTemp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                    if (fd < 0)
+                    {
+                        throw std::system_error(errno, std::system_category(), "mapped: cannot create " + pathTemp.string());
+                    }
+                    std::array<std::byte, alignment_v> const aPadding{};
+                    bool bWritten = write_all(fd, &header, sizeof(header)) && write_all(fd, aPadding.data(), alignment_v - sizeof(header));
+                    for (size_t i = 0; bWritten && i < sections.size(); ++i)
+                    {
+                        bWritten = write_all(fd, sections[i].data(), sections[i].size())
+                            && write_all(fd, aPadding.data(), (alignment_v - sections[i].size() % alignment_v) % alignment_v);
+                    }
+                    bWritten = bWritten && ::fsync(fd) == 0;
+                    int nError = errno;
+                    if (::close(fd) != 0 && bWritten)
+                    {
+                        bWritten = false;
+                        nError = errno;
+                    }
+                    std::error_code ec;
+                    if (!bWritten)
+                    {
+                        std::filesystem::remove(pathTemp, ec);
+                        throw std::system_error(nError, std::system_category(), "mapped: cannot write " + pathTemp.string());
+                    }
+                    std::filesystem::rename(pathTemp, path, ec);
+                    if (ec)
+                    {
+                        std::error_code ecRemove;
+                        std::filesystem::remove(pathTemp, ecRemove);
+                        throw std::system_error(ec, "mapped: cannot rename " + pathTemp.string());
+                    }
+                }
+            }
+
+            /**
+             * @brief Writes sorted keys for loading with index_t.
+             *
+             * @param path The file to create or replace.
+             * @param keys The sorted keys.
+             */
+            template <typename T>
+            void save(std::filesystem::path const & path, std::span<T const> const keys)
+            {
+                std::array<std::span<std::byte const>, 1> const aSection = { std::as_bytes(keys) };
+                details::write<T>(path, layout_kind::sorted, 0, keys.size(), aSection);
+            }
+
+            /**
+             * @brief Writes sorted keys together with the van Emde Boas layout built from them.
+             *
+             * @example
+             * jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb(keys);
+             * jrmwng::algorithm::mapped::save<uint64_t>("keys.idx", keys, veb);
+             */
+            template <typename T, typename Allocator>
+            void save(std::filesystem::path const & path, std::span<T const> const keys, layout::veb_layout_t<T, Allocator> const & veb)
+            {
+                if (veb.size() != keys.size())
+                {
+                    throw std::invalid_argument("mapped: the layout was built from a different number of keys");
+                }
+                std::array<std::span<std::byte const>, 2> const aSection = { std::as_bytes(keys), std::as_bytes(veb.view().nodes()) };
+                details::write<T>(path, layout_kind::veb, static_cast<uint32_t>(layout::veb_layout_t<T, Allocator>::node_keys_v), keys.size(), aSection);
+            }
+
+            struct load_options
+            {
+                bool verify_checksums = false;  // Verify every section on load; reads the whole file.
+                bool populate = false;          // Prefault the mapping (MAP_POPULATE) instead of faulting pages on first use.
+            };
+
+            /**
+             * @brief Sorted keys and their search layout, mapped read-only from a file written by save.
+             *
+             * @tparam T The type of the keys; must match the file.
+             *
+             * @example
+             * jrmwng::algorithm::mapped::index_t<uint64_t> index("keys.idx");
+             * size_t pos = index.lower_bound(42);
+             */
+            template <typename T>
+            class index_t
+            {
+                void * m_pMapped = MAP_FAILED;
+                size_t m_uMapped = 0;
+                details::file_header_t const * m_pHeader = nullptr;
+                std::span<T const> m_spanKey;
+                layout::veb_view_t<T> m_veb;
+
+                template <typename U>
+                std::span<U const> section(size_t const i) const
+                {
+                    details::section_t const & entry = m_pHeader->section[i];
+                    return std::span<U const>(reinterpret_cast<U const *>(static_cast<std::byte const *>(m_pMapped) + entry.offset), entry.bytes / sizeof(U));
+                }
+
+                void validate(load_options const & options)
+                {
+                    details::file_header_t const & header = *m_pHeader;
+                    if (std::memcmp(header.magic, details::magic_v, sizeof(header.magic)) != 0 || header.version != details::version_v
+                        || header.header_bytes != sizeof(details::file_header_t) || header.header_checksum != details::header_checksum(header))
+                    {
+                        throw std::runtime_error("mapped: not an index file of this version");
+                    }
+                    if (header.byte_order != details::byte_order_v)
+                    {
+                        throw std::runtime_error("mapped: the file was written with a different byte order");
+                    }
+                    if (header.key_size != sizeof(T) || header.key_kind != details::key_kind_v<T>)
+                    {
+                        throw std::runtime_error("mapped: the file holds a different key type");
+                    }
+                    size_t const uSections = (header.kind == static_cast<uint32_t>(layout_kind::veb)) ? 2 : 1;
+                    if (header.kind > static_cast<uint32_t>(layout_kind::veb) || header.sections != uSections)
+                    {
+                        throw std::runtime_error("mapped: unknown layout");
+                    }
+                    for (size_t i = 0; i < header.sections; ++i)
+                    {
+                        details::section_t const & entry = header.section[i];
+                        if (entry.offset % details::alignment_v != 0 || entry.offset > m_uMapped || entry.bytes > m_uMapped - entry.offset)
+                        {
+                            throw std::runtime_error("mapped: the file is truncated");
+                        }
+                        if (options.verify_checksums && details::checksum(section<std::byte>(i)) != entry.checksum)
+                        {
+                            throw std::runtime_error("mapped: checksum mismatch");
+                        }
+                    }
+                    if (header.section[0].bytes != header.count * sizeof(T))
+                    {
+                        throw std::runtime_error("mapped: the key section does not match the count");
+                    }
+                }
+
+                void unmap()
+                {
+                    if (m_pMapped != MAP_FAILED)
+                    {
+                        ::munmap(m_pMapped, m_uMapped);
+                        m_pMapped = MAP_FAILED;
+                    }
+                }
+
+            public:
+                explicit index_t(std::filesystem::path const & path, load_options const & options = {})
+                {
+                    int const fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0)
+                    {
+                        throw std::system_error(errno, std::system_category(), "mapped: cannot open the file");
+                    }
+                    struct stat st;
+                    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(details::file_header_t))
+                    {
+                        m_uMapped = static_cast<size_t>(st.st_size);
+                        m_pMapped = ::mmap(nullptr, m_uMapped, PROT_READ, MAP_SHARED | (options.populate ? MAP_POPULATE : 0), fd, 0);
+                    }
+                    int const nError = errno;
+                    ::close(fd);
+                    if (m_pMapped == MAP_FAILED)
+                    {
+                        if (m_uMapped == 0)
+                        {
+                            throw std::runtime_error("mapped: the file is truncated");
+                        }
+                        throw std::system_error(nError, std::system_category(), "mapped: cannot map the file");
+                    }
+                    m_pHeader = static_cast<details::file_header_t const *>(m_pMapped);
+                    try
+                    {
+                        validate(options);
+                        m_spanKey = section<T>(0);
+                        if (kind() == layout_kind::veb)
+                        {
+                            if (m_pHeader->layout_param != layout::veb_view_t<T>::node_keys_v)
+                            {
+                                throw std::runtime_error("mapped: the layout was built for a different node size");
+                            }
+                            std::span<T const> const spanNode = section<T>(1);
+                            if (spanNode.size() != layout::details::veb_shape_t(m_spanKey.size(), layout::veb_view_t<T>::node_keys_v).nodes * layout::veb_view_t<T>::node_keys_v)
+                            {
+                                throw std::runtime_error("mapped: the layout section does not match the count");
+                            }
+                            m_veb = layout::veb_view_t<T>(spanNode, m_spanKey.size());
+                        }
+                    }
+                    catch (...)
+                    {
+                        unmap();
+                        throw;
+                    }
+                }
+                index_t(index_t && that) noexcept
+                    : m_pMapped(std::exchange(that.m_pMapped, MAP_FAILED))
+                    , m_uMapped(that.m_uMapped)
+                    , m_pHeader(that.m_pHeader)
+                    , m_spanKey(that.m_spanKey)
+                    , m_veb(that.m_veb)
+                {
+                }
+                index_t(index_t const &) = delete;
+                index_t & operator=(index_t const &) = delete;
+                ~index_t()
+                {
+                    unmap();
+                }
+
+                size_t size() const
+                {
+                    return m_spanKey.size();
+                }
+
+                layout_kind kind() const
+                {
+                    return static_cast<layout_kind>(m_pHeader->kind);
+                }
+
+                /**
+                 * @brief Returns the sorted keys, in place in the mapping.
+                 */
+                std::span<T const> keys() const
+                {
+                    return m_spanKey;
+                }
+
+                /**
+                 * @brief Returns the van Emde Boas layout, in place in the mapping; empty unless kind() is layout_kind::veb.
+                 */
+                layout::veb_view_t<T> const & veb() const
+                {
+                    return m_veb;
+                }
+
+                /**
+                 * @brief Verifies the checksum of every section; reads the whole file.
+                 */
+                bool verify() const
+                {
+                    for (size_t i = 0; i < m_pHeader->sections; ++i)
+                    {
+                        if (details::checksum(section<std::byte>(i)) != m_pHeader->section[i].checksum)
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                /**
+                 * @brief Finds the position of the first key not less than the value, through the stored layout.
+                 */
+                size_t lower_bound(T const & value) const
+                {
+                    if (kind() == layout_kind::veb)
+                    {
+                        return m_veb.lower_bound(value);
+                    }
+                    return static_cast<size_t>(simd::lower_bound(m_spanKey, value) - m_spanKey.begin());
+                }
+            };
+        }
+    }
+}
+#endif
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+
+#include <bit>              // for std::bit_cast
+#include <cstdint>          // for uint32_t, uint64_t, int32_t, int64_t
+#include <limits>           // for std::numeric_limits
+#include <type_traits>      // for std::is_same_v
+#include <vector>           // for std::vector
+#include <memory>           // for std::allocator
+#include <algorithm>        // for std::ranges::sort, std::ranges::is_sorted
+#include <ranges>           // for std::ranges::input_range
+
+/**
+ * @file lower_bound_normalize.hpp
+ * @brief Provides order-preserving normalization of signed integer and floating-point keys to unsigned integers.
+ *
+ * Normalized keys of one width are all searched by the same unsigned integer compare kernel (simd_traits<uint32_t> or
+ * simd_traits<uint64_t>), so one code path serves int, float and double columns, and floating-point keys get a total order:
+ * - -0.0 and +0.0 normalize to the same key, as they compare equal under std::less;
+ * - every NaN, whatever its sign or payload, normalizes to the largest key, after +infinity.
+ * On NaN-free data the order is exactly that of std::less, so positions match std::lower_bound.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace keys
+        {
+            /**
+             * @brief Traits mapping a key type to its order-preserving unsigned integer representation.
+             *
+             * @tparam T The type of the key.
+             */
+            template <typename T>
+            struct normalize_traits;
+
+            /**
+             * @brief Base of normalize_traits for signed integers: flip the sign bit.
+             */
+            template <typename T, typename U>
+            struct signed_normalize_traits
+            {
+                using normalized_type = U;
+
+                constexpr static U sign_v = U(1) << (std::numeric_limits<U>::digits - 1);
+
+                constexpr static U encode(T const tValue)
+                {
+                    return static_cast<U>(tValue) ^ sign_v;
+                }
+                constexpr static T decode(U const uValue)
+                {
+                    return static_cast<T>(uValue ^ sign_v);
+                }
+            };
+
+            /**
+             * @brief Base of normalize_traits for IEEE-754 floating point: flip the sign bit of positives, all bits of negatives.
+             */
+            template <typename T, typename U>
+            struct floating_normalize_traits
+            {
+                using normalized_type = U;
+
+                constexpr static U sign_v = U(1) << (std::numeric_limits<U>::digits - 1);
+
+                constexpr static U encode(T const tValue)
+                {
+                    if (tValue != tValue)
+                    {
+                        // Every NaN after +infinity.
+                        return std::numeric_limits<U>::max();
+                    }
+                    if (tValue == T(0))
+                    {
+                        // -0.0 equal to +0.0.
+                        return sign_v;
+                    }
+                    U const uBits = std::bit_cast<U>(tValue);
+                    return (uBits & sign_v) ? ~uBits : (uBits | sign_v);
+                }
+                constexpr static T decode(U const uValue)
+                {
+                    return std::bit_cast<T>((uValue & sign_v) ? (uValue & ~sign_v) : ~uValue);
+                }
+            };
+
+            template <>
+            struct normalize_traits<int32_t> : signed_normalize_traits<int32_t, uint32_t>
+            {
+            };
+            template <>
+            struct normalize_traits<int64_t> : signed_normalize_traits<int64_t, uint64_t>
+            {
+            };
+            template <>
+            struct normalize_traits<float> : floating_normalize_traits<float, uint32_t>
+            {
+            };
+            template <>
+            struct normalize_traits<double> : floating_normalize_traits<double, uint64_t>
+            {
+            };
+            template <>
+            struct normalize_traits<uint32_t>
+            {
+                using normalized_type = uint32_t;
+
+                constexpr static uint32_t encode(uint32_t const uValue)
+                {
+                    return uValue;
+                }
+                constexpr static uint32_t decode(uint32_t const uValue)
+                {
+                    return uValue;
+                }
+            };
+            template <>
+            struct normalize_traits<uint64_t>
+            {
+                using normalized_type = uint64_t;
+
+                constexpr static uint64_t encode(uint64_t const uValue)
+                {
+                    return uValue;
+                }
+                constexpr static uint64_t decode(uint64_t const uValue)
+                {
+                    return uValue;
+                }
+            };
+
+            /**
+             * @brief The normalized key type of T: uint32_t for 32-bit keys, uint64_t for 64-bit keys.
+             */
+            template <typename T>
+            using normalized_t = typename normalize_traits<T>::normalized_type;
+
+            /**
+             * @brief Maps a key to an unsigned integer with the same order.
+             *
+             * @example
+             * jrmwng::algorithm::keys::normalize(-1.5f) < jrmwng::algorithm::keys::normalize(0.0f) // true
+             */
+            template <typename T>
+            constexpr normalized_t<T> normalize(T const tValue)
+            {
+                return normalize_traits<T>::encode(tValue);
+            }
+
+            /**
+             * @brief Maps a normalized key back. NaNs come back as a quiet NaN, -0.0 as +0.0.
+             */
+            template <typename T>
+            constexpr T denormalize(normalized_t<T> const uValue)
+            {
+                return normalize_traits<T>::decode(uValue);
+            }
+
+            /**
+             * @brief Strict weak order on keys that agrees with the normalized order, including NaNs and signed zeros.
+             */
+            struct total_less
+            {
+                template <typename T>
+                constexpr bool operator()(T const & lhs, T const & rhs) const
+                {
+                    return normalize(lhs) < normalize(rhs);
+                }
+            };
+
+            /**
+             * @brief A packed array of normalized keys, searched by the unsigned integer SIMD kernel.
+             *
+             * @tparam T The type of the original keys.
+             * @tparam Allocator The allocator of the normalized keys.
+             *
+             * @example
+             * std::vector<float> column = {NAN, -1.0f, 2.5f, -0.0f};
+             * jrmwng::algorithm::keys::normalized_array_t<float> keys(column); // sorted as -1.0, -0.0, 2.5, NaN
+             * size_t pos = keys.lower_bound(0.0f);                            // 1
+             */
+            template <typename T, typename Allocator = std::allocator<normalized_t<T>>>
+            class normalized_array_t
+            {
+                std::vector<normalized_t<T>, Allocator> m_vecKey;
+
+            public:
+                using normalized_type = normalized_t<T>;
+
+                /**
+                 * @brief Normalizes the keys of a range, sorting them unless they are already in normalized order.
+                 *
+                 * @param r The keys. Keys containing NaNs need not be sorted beforehand.
+                 */
+                template <typename Range>
+                requires std::ranges::input_range<Range>
+                explicit normalized_array_t(Range && r, Allocator const & allocator = Allocator())
+                    : m_vecKey(allocator)
+                {
+                    if constexpr (std::ranges::sized_range<Range>)
+                    {
+                        m_vecKey.reserve(static_cast<size_t>(std::ranges::size(r)));
+                    }
+                    for (auto const & tKey : r)
+                    {
+                        m_vecKey.push_back(normalize(static_cast<T>(tKey)));
+                    }
+                    if (!std::ranges::is_sorted(m_vecKey))
+                    {
+                        std::ranges::sort(m_vecKey);
+                    }
+                }
+
+                size_t size() const
+                {
+                    return m_vecKey.size();
+                }
+
+                /**
+                 * @brief Returns the original key at a position.
+                 */
+                T operator[](size_t const uIndex) const
+                {
+                    return denormalize<T>(m_vecKey[uIndex]);
+                }
+
+                /**
+                 * @brief Returns the packed normalized keys.
+                 */
+                std::vector<normalized_type, Allocator> const & normalized() const
+                {
+                    return m_vecKey;
+                }
+
+                /**
+                 * @brief Finds the first position whose key is not less than the value in the normalized order.
+                 */
+                size_t lower_bound(T const tValue) const
+                {
+                    return static_cast<size_t>(simd::lower_bound(m_vecKey, normalize(tValue)) - m_vecKey.begin());
+                }
+
+                /**
+                 * @brief Finds the first position whose key is greater than the value in the normalized order.
+                 */
+                size_t upper_bound(T const tValue) const
+                {
+                    normalized_type const uValue = normalize(tValue);
+                    if (uValue == std::numeric_limits<normalized_type>::max())
+                    {
+                        return m_vecKey.size();
+                    }
+                    return static_cast<size_t>(simd::lower_bound(m_vecKey, static_cast<normalized_type>(uValue + 1)) - m_vecKey.begin());
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,380 @@
+#pragma once
+
+#include "lower_bound_simd.hpp"         // Project-specific header for simd::lower_bound
+#include "lower_bound_huge_page.hpp"    // Project-specific header for memory::details::allocate, memory::huge_page_size_v
+
+#include <span>             // for std::span
+#include <vector>           // for std::vector
+#include <string>           // for std::string, std::stoul
+#include <fstream>          // for std::ifstream
+#include <memory>           // for std::unique_ptr
+#include <cstring>          // for std::memcpy
+#include <algorithm>        // for std::min, std::max
+#include <cstdint>          // for uint16_t
+#include <new>              // for std::bad_alloc
+#include <concepts>         // for std::same_as
+#include <type_traits>      // for std::is_trivially_copyable_v
+
+#if defined(__linux__)
+#include <sched.h>          // for sched_getcpu
+#include <sys/mman.h>       // for mmap, munmap
+#include <sys/syscall.h>    // for SYS_mbind
+#include <unistd.h>         // for syscall, sysconf
+#endif
+
+/**
+ * @file lower_bound_numa.hpp
+ * @brief Provides a read-only sorted array, or prebuilt layout, replicated once per NUMA node.
+ *
+ * Threads searching an array allocated on a remote socket pay remote-memory latency on every lookup.
+ * replicated_t copies the array once per node into a page-granular mapping of its own, binds each copy to its node
+ * with `mbind` whatever its size, and routes each lookup to the replica local to the calling thread. The node topology
+ * is read from sysfs, so no libnuma is needed; on single-node machines and non-Linux targets there is exactly one replica.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace numa
+        {
+            namespace details
+            {
+                /**
+                 * @brief Parses a sysfs CPU or node list such as "0-3,8,10-11".
+                 *
+                 * @param strList The list.
+                 * @return std::vector<size_t> The listed numbers in ascending order.
+                 */
+                inline std::vector<size_t> parse_list(std::string const & strList)
+                {
+                    std::vector<size_t> vecResult;
+                    size_t uPos = 0;
+                    while (uPos < strList.size())
+                    {
+                        size_t const uComma = std::min(strList.find(',', uPos), strList.size());
+                        std::string const strItem = strList.substr(uPos, uComma - uPos);
+                        size_t const uDash = strItem.find('-');
+                        if (!strItem.empty() && strItem.find_first_not_of("0123456789-\n") == std::string::npos)
+                        {
+                            size_t const uFirst = std::stoul(strItem.substr(0, uDash));
+                            size_t const uLast = (uDash == std::string::npos) ? uFirst : std::stoul(strItem.substr(uDash + 1));
+                            for (size_t u = uFirst; u <= uLast; ++u)
+                            {
+                                vecResult.push_back(u);
+                            }
+                        }
+                        uPos = uComma + 1;
+                    }
+                    return vecResult;
+                }
+
+                /**
+                 * @brief The NUMA topology of the host.
+                 */
+                struct topology_t
+                {
+                    size_t node_count = 1;                  ///< Number of replicas, i.e. one past the highest online node.
+                    std::vector<uint16_t> cpu_to_node;      ///< Node of each CPU; CPUs beyond the table map to node 0.
+
+                    topology_t()
+                    {
+#if defined(__linux__)
+                        std::ifstream ifsOnline("/sys/devices/system/node/online");
+                        std::string strOnline;
+                        if (!std::getline(ifsOnline, strOnline))
+                        {
+                            return;
+                        }
+                        for (size_t const uNode : parse_list(strOnline))
+                        {
+                            node_count = std::max(node_count, uNode + 1);
+
+                            std::ifstream ifsCpus("/sys/devices/system/node/node" + std::to_string(uNode) + "/cpulist");
+                            std::string strCpus;
+                            std::getline(ifsCpus, strCpus);
+                            for (size_t const uCpu : parse_list(strCpus))
+                            {
+                                if (cpu_to_node.size() <= uCpu)
+                                {
+                                    cpu_to_node.resize(uCpu + 1, 0);
+                                }
+                                cpu_to_node[uCpu] = static_cast<uint16_t>(uNode);
+                            }
+                        }
+#endif
+                    }
+                };
+
+                inline topology_t const & topology()
+                {
+                    static topology_t const s_topology;
+                    return s_topology;
+                }
+
+                /**
+                 * @brief Returns the bytes mapped for a replica: whole pages below a huge page, whole huge pages above.
+                 */
+                inline size_t mapped_bytes(size_t const uBytes)
+                {
+#if defined(__linux__)
+                    if (uBytes < memory::huge_page_size_v)
+                    {
+                        static size_t const s_uPage = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+                        return memory::details::round_up(uBytes, s_uPage);
+                    }
+#endif
+                    return memory::details::round_up(uBytes, memory::huge_page_size_v);
+                }
+
+                /**
+                 * @brief Allocates replica storage that shares no page with any other allocation, so that it can be bound.
+                 *
+                 * Replicas of at least a huge page come from memory::details::allocate; smaller ones are mapped page by page.
+                 */
+                inline void * allocate(size_t const uBytes)
+                {
+#if defined(__linux__)
+                    if (uBytes < memory::huge_page_size_v)
+                    {
+                        void * const p = ::mmap(nullptr, mapped_bytes(uBytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                        if (p == MAP_FAILED)
+                        {
+                            throw std::bad_alloc();
+                        }
+                        return p;
+                    }
+#endif
+                    return memory::details::allocate(uBytes, memory::huge_page_policy::transparent);
+                }
+
+                /**
+                 * @brief Releases storage obtained from allocate with the same byte count.
+                 */
+                inline void deallocate(void * const p, size_t const uBytes)
+                {
+#if defined(__linux__)
+                    if (uBytes < memory::huge_page_size_v)
+                    {
+                        ::munmap(p, mapped_bytes(uBytes));
+                        return;
+                    }
+#endif
+                    memory::details::deallocate(p, uBytes);
+                }
+
+                /**
+                 * @brief Binds the pages of a replica obtained from allocate to one node.
+                 *
+                 * @return true if the pages are bound; false on single-node machines, non-Linux targets and when `mbind`
+                 * failed, in which case the pages fall back to the first-touch policy.
+                 */
+                inline bool bind(void * const p, size_t const uBytes, size_t const uNode)
+                {
+#if defined(__linux__) && defined(SYS_mbind)
+                    if (topology().node_count > 1)
+                    {
+                        constexpr int mpol_bind_v = 2; // MPOL_BIND from <linux/mempolicy.h>
+                        constexpr size_t bits_v = sizeof(unsigned long) * 8;
+                        std::vector<unsigned long> vecMask(uNode / bits_v + 1, 0);
+                        vecMask[uNode / bits_v] = 1ul << (uNode % bits_v);
+                        return ::syscall(SYS_mbind, p, mapped_bytes(uBytes), mpol_bind_v, vecMask.data(), vecMask.size() * bits_v + 1, 0) == 0;
+                    }
+#else
+                    static_cast<void>(p);
+                    static_cast<void>(uBytes);
+                    static_cast<void>(uNode);
+#endif
+                    return false;
+                }
+
+                /**
+                 * @brief Deleter for replica storage obtained from allocate.
+                 */
+                struct replica_deleter_t
+                {
+                    size_t bytes;
+
+                    void operator()(void * const p) const
+                    {
+                        deallocate(p, bytes);
+                    }
+                };
+            }
+
+            /**
+             * @brief Returns the number of NUMA nodes, 1 on single-node machines and non-Linux targets.
+             */
+            inline size_t node_count()
+            {
+                return details::topology().node_count;
+            }
+
+            /**
+             * @brief Returns the NUMA node of the CPU the calling thread runs on.
+             */
+            inline size_t current_node()
+            {
+#if defined(__linux__)
+                std::vector<uint16_t> const & vecCpuToNode = details::topology().cpu_to_node;
+                int const nCpu = ::sched_getcpu();
+                if (nCpu >= 0 && static_cast<size_t>(nCpu) < vecCpuToNode.size())
+                {
+                    return vecCpuToNode[static_cast<size_t>(nCpu)];
+                }
+#endif
+                return 0;
+            }
+
+            /**
+             * @brief A read-only sorted array, or prebuilt layout, replicated once per NUMA node.
+             *
+             * @tparam T The type of the elements. Replicas are copied bytewise.
+             * @tparam View How each replica is searched: std::span<T const> searches it as a sorted array with
+             * simd::lower_bound; a layout view such as layout::veb_view_t is rebuilt over each replica of its nodes.
+             *
+             * Replicas take no allocator: each needs pages of its own to be bound, and those of at least 2MB are huge-page backed.
+             *
+             * @example
+             * jrmwng::algorithm::numa::replicated_t<int> replicated(vec);
+             * size_t pos = replicated.lower_bound(42); // searched on the caller's node
+             *
+             * jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+             * jrmwng::algorithm::numa::replicated_t<int, jrmwng::algorithm::layout::veb_view_t<int>> replicated_veb(veb.view());
+             * size_t pos_veb = replicated_veb.lower_bound(42); // the position in vec
+             */
+            template <typename T, typename View = std::span<T const>>
+            class replicated_t
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Replicas are copied bytewise");
+
+                constexpr static bool is_array_v = std::same_as<View, std::span<T const>>;
+
+                size_t m_uSize;
+                size_t m_uCount;    // The number of elements in each replica: the keys of an array, the nodes of a layout.
+                std::vector<std::unique_ptr<void, details::replica_deleter_t>> m_vecReplica;
+                std::vector<View> m_vecView;
+                std::vector<bool> m_vecBound;
+
+                void replicate(std::span<T const> const data)
+                {
+                    size_t const uBytes = std::max<size_t>(data.size_bytes(), sizeof(T));
+                    for (size_t uNode = 0; uNode < node_count(); ++uNode)
+                    {
+                        void * const p = details::allocate(uBytes);
+                        m_vecReplica.emplace_back(p, details::replica_deleter_t{ uBytes });
+                        // Bind before the copy, so the first touch already faults the pages in on the target node.
+                        m_vecBound.push_back(details::bind(p, uBytes, uNode));
+                        if (!data.empty())
+                        {
+                            std::memcpy(p, data.data(), data.size_bytes());
+                        }
+                        if constexpr (is_array_v)
+                        {
+                            m_vecView.emplace_back(static_cast<T const *>(p), m_uCount);
+                        }
+                        else
+                        {
+                            m_vecView.emplace_back(std::span<T const>(static_cast<T const *>(p), m_uCount), m_uSize);
+                        }
+                    }
+                }
+
+            public:
+                /**
+                 * @brief Copies a sorted array once per NUMA node.
+                 *
+                 * @param data The sorted array.
+                 */
+                explicit replicated_t(std::span<T const> data) requires is_array_v
+                    : m_uSize(data.size())
+                    , m_uCount(data.size())
+                {
+                    replicate(data);
+                }
+
+                /**
+                 * @brief Copies the nodes of a prebuilt layout once per NUMA node.
+                 *
+                 * @param view The layout; View must be constructible from its nodes and its size.
+                 */
+                explicit replicated_t(View const & view) requires (!is_array_v)
+                    : m_uSize(view.size())
+                    , m_uCount(view.nodes().size())
+                {
+                    replicate(view.nodes());
+                }
+
+                /**
+                 * @brief Returns the number of keys searched.
+                 */
+                size_t size() const
+                {
+                    return m_uSize;
+                }
+
+                size_t replicas() const
+                {
+                    return m_vecReplica.size();
+                }
+
+                /**
+                 * @brief Returns whether a replica's pages are bound to its node.
+                 *
+                 * @return false on single-node machines, on non-Linux targets and when `mbind` failed; such a replica is
+                 * placed by the first-touch policy, i.e. on the node of the constructing thread.
+                 */
+                bool bound(size_t const uNode) const
+                {
+                    return uNode < m_vecBound.size() && m_vecBound[uNode];
+                }
+
+                /**
+                 * @brief Returns the elements of the replica for a node: the sorted keys, or the nodes of the layout.
+                 */
+                std::span<T const> replica(size_t const uNode) const
+                {
+                    return std::span<T const>(static_cast<T const *>(m_vecReplica[uNode < m_vecReplica.size() ? uNode : 0].get()), m_uCount);
+                }
+
+                /**
+                 * @brief Returns the elements of the replica local to the calling thread.
+                 */
+                std::span<T const> local() const
+                {
+                    return replica(current_node());
+                }
+
+                /**
+                 * @brief Returns the view searching the replica for a node.
+                 */
+                View const & view(size_t const uNode) const
+                {
+                    return m_vecView[uNode < m_vecView.size() ? uNode : 0];
+                }
+
+                /**
+                 * @brief Finds the lower bound in the replica local to the calling thread.
+                 *
+                 * @param value The value to compare.
+                 * @param comp The comparison function.
+                 * @param proj The projection function.
+                 * @return size_t The position of the lower bound in the sorted keys, identical in every replica.
+                 */
+                template <typename U, typename Compare = std::less<U>, typename Projection = std::identity>
+                size_t lower_bound(U const & value, Compare comp = {}, Projection proj = {}) const
+                {
+                    View const & viewLocal = view(current_node());
+                    if constexpr (is_array_v)
+                    {
+                        return static_cast<size_t>(simd::lower_bound(viewLocal, value, comp, proj) - viewLocal.begin());
+                    }
+                    else
+                    {
+                        return viewLocal.lower_bound(value, comp, proj);
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>          // for size_t
+#include <exception>        // for std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <thread>           // for std::thread
+#include <vector>           // for std::vector
+
+/**
+ * @file lower_bound_parallel.hpp
+ * @brief Provides the fork-join helper the multi-threaded builders share.
+ *
+ * Exceptions never escape a worker thread, which would call std::terminate: each worker's exception is captured, every
+ * started thread is joined, and only then is the first exception rethrown on the calling thread.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace parallel
+        {
+            /**
+             * @brief Runs fnWork(t) for every t in [0, uThreads), t = 0 on the calling thread and the others each on their own
+             * thread, and waits for them.
+             *
+             * @param uThreads The number of workers; 0 runs nothing.
+             * @param fnWork Invoked with the worker index.
+             * @throws The exception of the lowest-indexed worker that threw, or std::system_error if a thread could not be
+             * started, once every started thread has finished.
+             */
+            template <typename Twork>
+            void parallel_for(size_t const uThreads, Twork && fnWork)
+            {
+                if (uThreads == 0)
+                {
+                    return;
+                }
+                std::vector<std::exception_ptr> vecError(uThreads);
+                auto const fnGuarded = [&](size_t const t)
+                {
+                    try
+                    {
+                        fnWork(t);
+                    }
+                    catch (...)
+                    {
+                        vecError[t] = std::current_exception();
+                    }
+                };
+
+                std::vector<std::thread> vecThread;
+                vecThread.reserve(uThreads - 1);
+                try
+                {
+                    for (size_t t = 1; t < uThreads; ++t)
+                    {
+                        vecThread.emplace_back(fnGuarded, t);
+                    }
+                }
+                catch (...)
+                {
+                    // The workers already started still reference fnWork: let them finish before unwinding.
+                    for (std::thread & thread : vecThread)
+                    {
+                        thread.join();
+                    }
+                    throw;
+                }
+                fnGuarded(0);
+                for (std::thread & thread : vecThread)
+                {
+                    thread.join();
+                }
+                for (std::exception_ptr const & error : vecError)
+                {
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
+                    }
+                }
+            }
+        }
+    }
+}
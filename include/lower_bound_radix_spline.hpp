@@ -0,0 +1,290 @@
+#pragma once
+
+#include "lower_bound_simd.hpp"      // Project-specific header for simd::lower_bound
+#include "lower_bound_normalize.hpp" // Project-specific header for keys::normalize
+
+#include <span>             // for std::span
+#include <vector>           // for std::vector
+#include <memory>           // for std::allocator, std::allocator_traits
+#include <bit>              // for std::bit_width
+#include <limits>           // for std::numeric_limits
+#include <utility>          // for std::pair
+#include <algorithm>        // for std::min, std::max, std::clamp
+#include <cstdint>          // for uint32_t
+#include <stdexcept>        // for std::invalid_argument, std::length_error
+
+/**
+ * @file lower_bound_radix_spline.hpp
+ * @brief Provides a radix table, optionally over an error-bounded spline, that narrows searches of integer keys to a small window.
+ *
+ * Keys are normalized with keys::normalize and offset by the smallest key; the top r bits of the offset select a bin of a
+ * direct-lookup table of 2^r + 1 entries. Without a spline, the table holds, per bin, the position of its first key, so a
+ * bin's keys lie between consecutive entries and simd::lower_bound searches only them. With a spline of error E (Kipf et
+ * al., RadixSpline), the table indexes spline knots instead: points of the key-to-position mapping, chosen by a greedy
+ * corridor so that interpolating between neighbouring knots predicts the position of every key within E. A lookup finds
+ * its knots through the table, interpolates, and searches the 2E + 2 positions around the prediction. Both are built in one
+ * linear pass over the sorted keys. The spline suits skewed keys, where bins of the plain table fill unevenly; uniformly
+ * distributed keys such as hashed IDs fill a plain table evenly and need no spline.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace layout
+        {
+            /**
+             * @brief A radix table over a sorted array of integer keys, optionally indexing a spline of the keys' positions.
+             *
+             * @tparam T The type of the keys; any type supported by keys::normalize. Floating-point keys must be NaN-free.
+             * @tparam Position The unsigned type of the positions held by the table and the knots; it must index every key.
+             * @tparam Allocator The allocator of the table and the knot positions; the knot keys use it rebound.
+             *
+             * @example
+             * std::vector<uint64_t> ids = ...; // sorted, must outlive the index
+             * jrmwng::algorithm::layout::radix_spline_t<uint64_t> index(ids);        // plain radix table
+             * jrmwng::algorithm::layout::radix_spline_t<uint64_t> spline(ids, 18, 32); // 2^18 bins over a spline of error 32
+             * jrmwng::algorithm::layout::radix_spline_t<uint64_t, size_t> huge(ids);  // more than 2^32 - 1 keys
+             * size_t pos = index.lower_bound(42);
+             */
+            template <typename T, typename Position = uint32_t, typename Allocator = std::allocator<Position>>
+            class radix_spline_t
+            {
+                using normalized_type = keys::normalized_t<T>;
+                using key_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<normalized_type>;
+
+                std::span<T const> m_spanKey;
+                size_t m_uRadixBits;
+                size_t m_uError;                    // The spline error; 0 when the table indexes the keys directly.
+                normalized_type m_uMin;
+                normalized_type m_uRange;           // The largest key's offset from the smallest.
+                unsigned m_uShift;
+                std::vector<Position, Allocator> m_vecTable; // Per bin, the first key (or knot) in it; one more entry for the end.
+                std::vector<normalized_type, key_allocator_type> m_vecKnotKey; // Offsets of the knots from the smallest key.
+                std::vector<Position, Allocator> m_vecKnotPos;
+
+                size_t bin(normalized_type const uOffset) const
+                {
+                    return static_cast<size_t>(uOffset >> m_uShift);
+                }
+
+                /**
+                 * @brief Appends an entry in ascending order to the radix table, filling the bins up to its own.
+                 */
+                void fill_table(normalized_type const uOffset, size_t const uIndex, size_t & uNextBin)
+                {
+                    for (size_t const uBin = bin(uOffset); uNextBin <= uBin; ++uNextBin)
+                    {
+                        m_vecTable[uNextBin] = static_cast<Position>(uIndex);
+                    }
+                }
+
+                void add_knot(normalized_type const uOffset, size_t const uPos, size_t & uNextBin)
+                {
+                    fill_table(uOffset, m_vecKnotKey.size(), uNextBin);
+                    m_vecKnotKey.push_back(uOffset);
+                    m_vecKnotPos.push_back(static_cast<Position>(uPos));
+                }
+
+                /**
+                 * @brief Predicts the position of a key's offset by interpolating between the knots around it.
+                 */
+                size_t predict(normalized_type const uOffset) const
+                {
+                    size_t const uBin = bin(uOffset);
+                    size_t const uFirst = m_vecTable[uBin];
+                    size_t const uLast = m_vecTable[uBin + 1];
+                    // The first knot greater than the offset ends the segment; the knot before it, possibly in an earlier bin, starts it.
+                    std::span<normalized_type const> const spanKnot(m_vecKnotKey.data() + uFirst, uLast - uFirst);
+                    size_t const uUpper = (uOffset == std::numeric_limits<normalized_type>::max()) ? uLast
+                        : uFirst + static_cast<size_t>(simd::lower_bound(spanKnot, static_cast<normalized_type>(uOffset + 1)) - spanKnot.begin());
+                    if (uUpper == m_vecKnotKey.size())
+                    {
+                        return m_vecKnotPos.back();
+                    }
+                    size_t const i = uUpper - 1;
+                    double const dSlope = static_cast<double>(m_vecKnotPos[i + 1] - m_vecKnotPos[i]) / static_cast<double>(m_vecKnotKey[i + 1] - m_vecKnotKey[i]);
+                    return m_vecKnotPos[i] + static_cast<size_t>(static_cast<double>(uOffset - m_vecKnotKey[i]) * dSlope);
+                }
+
+                size_t search(T const tValue, size_t const uFirst, size_t const uLast) const
+                {
+                    std::span<T const> const spanWindow = m_spanKey.subspan(uFirst, uLast - uFirst);
+                    return uFirst + static_cast<size_t>(simd::lower_bound(spanWindow, tValue) - spanWindow.begin());
+                }
+
+            public:
+                /**
+                 * @brief Builds the table, and the spline if requested, in one pass over a sorted array.
+                 *
+                 * @param data The sorted keys. The index refers to them and must not outlive them.
+                 * @param uRadixBits The number r of top bits indexing the table, at most 30; 0 picks bit_width(size) - 2, about 4 keys per bin.
+                 * @param uSplineError The spline error E in positions; 0 for no spline.
+                 * @param allocator The allocator of the table and the knots.
+                 * @throws std::length_error if Position cannot index every key.
+                 */
+                explicit radix_spline_t(std::span<T const> data, size_t uRadixBits = 0, size_t const uSplineError = 0, Allocator const & allocator = Allocator())
+                    : m_spanKey(data)
+                    , m_uRadixBits(uRadixBits)
+                    , m_uError(uSplineError)
+                    , m_uMin(0)
+                    , m_uRange(0)
+                    , m_uShift(0)
+                    , m_vecTable(allocator)
+                    , m_vecKnotKey(key_allocator_type(allocator))
+                    , m_vecKnotPos(allocator)
+                {
+                    if (m_uRadixBits == 0)
+                    {
+                        m_uRadixBits = std::clamp<size_t>(static_cast<size_t>(std::bit_width(data.size())), 3, 28) - 2;
+                    }
+                    if (m_uRadixBits > 30)
+                    {
+                        throw std::invalid_argument("radix_spline_t: at most 30 radix bits");
+                    }
+                    if (data.size() > std::numeric_limits<Position>::max())
+                    {
+                        throw std::length_error("radix_spline_t: more keys than the position type can index");
+                    }
+                    if (data.empty())
+                    {
+                        return;
+                    }
+
+                    m_uMin = keys::normalize(data.front());
+                    m_uRange = keys::normalize(data.back()) - m_uMin;
+                    m_uShift = std::bit_width(m_uRange) > m_uRadixBits ? static_cast<unsigned>(std::bit_width(m_uRange) - m_uRadixBits) : 0;
+                    m_vecTable.resize(bin(m_uRange) + 2);
+
+                    size_t uNextBin = 0;
+                    if (m_uError == 0)
+                    {
+                        for (size_t i = 0; i < data.size(); ++i)
+                        {
+                            fill_table(keys::normalize(data[i]) - m_uMin, i, uNextBin);
+                        }
+                        std::fill(m_vecTable.begin() + static_cast<std::ptrdiff_t>(uNextBin), m_vecTable.end(), static_cast<Position>(data.size()));
+                        return;
+                    }
+
+                    // Greedy spline corridor over the first position of each distinct key: the slopes from the last knot that
+                    // stay within E of every point since narrow with each point; a point outside them makes its predecessor a knot.
+                    double const dError = static_cast<double>(m_uError);
+                    add_knot(0, 0, uNextBin);
+                    normalized_type uPrevKey = 0;
+                    size_t uPrevPos = 0;
+                    double dLowSlope = -std::numeric_limits<double>::infinity();
+                    double dHighSlope = std::numeric_limits<double>::infinity();
+                    for (size_t i = 1; i < data.size(); ++i)
+                    {
+                        normalized_type const uKey = keys::normalize(data[i]) - m_uMin;
+                        if (uKey == uPrevKey)
+                        {
+                            continue;
+                        }
+                        double const dx = static_cast<double>(uKey - m_vecKnotKey.back());
+                        double const dy = static_cast<double>(i) - static_cast<double>(m_vecKnotPos.back());
+                        if (dy / dx < dLowSlope || dy / dx > dHighSlope)
+                        {
+                            add_knot(uPrevKey, uPrevPos, uNextBin);
+                            double const dxPrev = static_cast<double>(uKey - uPrevKey);
+                            double const dyPrev = static_cast<double>(i - uPrevPos);
+                            dLowSlope = (dyPrev - dError) / dxPrev;
+                            dHighSlope = (dyPrev + dError) / dxPrev;
+                        }
+                        else
+                        {
+                            dLowSlope = std::max(dLowSlope, (dy - dError) / dx);
+                            dHighSlope = std::min(dHighSlope, (dy + dError) / dx);
+                        }
+                        uPrevKey = uKey;
+                        uPrevPos = i;
+                    }
+                    if (m_vecKnotKey.back() != uPrevKey)
+                    {
+                        add_knot(uPrevKey, uPrevPos, uNextBin);
+                    }
+                    std::fill(m_vecTable.begin() + static_cast<std::ptrdiff_t>(uNextBin), m_vecTable.end(), static_cast<Position>(m_vecKnotKey.size()));
+                }
+
+                size_t radix_bits() const
+                {
+                    return m_uRadixBits;
+                }
+
+                /**
+                 * @brief Returns the number of spline knots; 0 without a spline.
+                 */
+                size_t knots() const
+                {
+                    return m_vecKnotKey.size();
+                }
+
+                /**
+                 * @brief Returns the bytes held by the table and the knots.
+                 */
+                size_t bytes() const
+                {
+                    return m_vecTable.size() * sizeof(Position) + m_vecKnotKey.size() * (sizeof(normalized_type) + sizeof(Position));
+                }
+
+                /**
+                 * @brief Narrows the lower bound of a value to a window of positions.
+                 *
+                 * With a spline, the window holds the lower bound of every key in the array and of values between keys that
+                 * occur once; lower_bound widens the search when a run of duplicates pushes the lower bound out of it.
+                 *
+                 * @return std::pair<size_t, size_t> The [first, last) positions to search.
+                 */
+                std::pair<size_t, size_t> window(T const tValue) const
+                {
+                    if (m_spanKey.empty())
+                    {
+                        return { 0, 0 };
+                    }
+                    normalized_type const uValue = keys::normalize(tValue);
+                    if (uValue <= m_uMin)
+                    {
+                        return { 0, 0 };
+                    }
+                    if (uValue - m_uMin > m_uRange)
+                    {
+                        return { m_spanKey.size(), m_spanKey.size() };
+                    }
+                    normalized_type const uOffset = uValue - m_uMin;
+                    if (m_uError == 0)
+                    {
+                        size_t const uBin = bin(uOffset);
+                        return { m_vecTable[uBin], m_vecTable[uBin + 1] };
+                    }
+                    size_t const uPredicted = predict(uOffset);
+                    return { uPredicted - std::min(uPredicted, m_uError), std::min(uPredicted + m_uError + 2, m_spanKey.size()) };
+                }
+
+                /**
+                 * @brief Finds the first position in the array where the value could be inserted without violating the order.
+                 *
+                 * @param tValue The value to compare.
+                 * @return size_t The position of the lower bound.
+                 */
+                size_t lower_bound(T const tValue) const
+                {
+                    auto const [uFirst, uLast] = window(tValue);
+                    size_t const uFound = search(tValue, uFirst, uLast);
+                    if (m_uError != 0)
+                    {
+                        if (uFound == uFirst && uFirst > 0 && !(m_spanKey[uFirst - 1] < tValue))
+                        {
+                            return search(tValue, 0, uFirst);
+                        }
+                        if (uFound == uLast && uLast < m_spanKey.size() && m_spanKey[uLast] < tValue)
+                        {
+                            return search(tValue, uLast, m_spanKey.size());
+                        }
+                    }
+                    return uFound;
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+
+#include <vector>           // for std::vector
+#include <memory>           // for std::allocator, std::allocator_traits
+#include <ranges>           // for std::ranges::input_range
+#include <utility>          // for std::pair
+#include <functional>       // for std::less, std::identity
+
+/**
+ * @file lower_bound_run_length.hpp
+ * @brief Provides a run-length-encoded index for sorted arrays with few distinct keys.
+ *
+ * A sorted column with d distinct keys over n rows is stored as the d distinct keys plus d + 1 run start offsets, the last
+ * being n. lower_bound, upper_bound and equal_range are answered by one simd::lower_bound over the distinct keys followed by
+ * one or two offset loads, so a search touches O(log d) keys instead of O(log n) rows, and no level is spent narrowing
+ * inside a run of equal keys.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace layout
+        {
+            /**
+             * @brief A sorted array stored as its distinct keys and the offsets where their runs start.
+             *
+             * @tparam T The type of the keys.
+             * @tparam Allocator The allocator of the distinct keys; the offsets use the same allocator rebound to size_t.
+             *
+             * @example
+             * std::vector<int> column = {3, 3, 3, 5, 5, 9};
+             * jrmwng::algorithm::layout::run_length_t<int> runs(column);
+             * auto [first, last] = runs.equal_range(5); // 3, 5
+             */
+            template <typename T, typename Allocator = std::allocator<T>>
+            class run_length_t
+            {
+                using offset_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+
+                std::vector<T, Allocator> m_vecKey;
+                std::vector<size_t, offset_allocator_type> m_vecOffset;
+
+                /**
+                 * @brief Returns the index of the first distinct key not less than the value.
+                 */
+                template <typename Compare>
+                size_t key_lower_bound(T const & value, Compare const & comp) const
+                {
+                    return static_cast<size_t>(simd::lower_bound(m_vecKey, value, comp) - m_vecKey.begin());
+                }
+
+            public:
+                /**
+                 * @brief Encodes the runs of a sorted range in one pass.
+                 *
+                 * @param r The sorted keys.
+                 */
+                template <typename Range>
+                requires std::ranges::input_range<Range>
+                explicit run_length_t(Range && r, Allocator const & allocator = Allocator())
+                    : m_vecKey(allocator)
+                    , m_vecOffset(offset_allocator_type(allocator))
+                {
+                    size_t uRow = 0;
+                    for (auto const & tKey : r)
+                    {
+                        if (m_vecKey.empty() || m_vecKey.back() < tKey || tKey < m_vecKey.back())
+                        {
+                            m_vecKey.push_back(tKey);
+                            m_vecOffset.push_back(uRow);
+                        }
+                        ++uRow;
+                    }
+                    m_vecOffset.push_back(uRow);
+                    m_vecKey.shrink_to_fit();
+                    m_vecOffset.shrink_to_fit();
+                }
+
+                /**
+                 * @brief Returns the number of rows.
+                 */
+                size_t size() const
+                {
+                    return m_vecOffset.back();
+                }
+
+                /**
+                 * @brief Returns the distinct keys.
+                 */
+                std::vector<T, Allocator> const & keys() const
+                {
+                    return m_vecKey;
+                }
+
+                /**
+                 * @brief Returns the run start offsets, one per distinct key followed by size().
+                 */
+                std::vector<size_t, offset_allocator_type> const & offsets() const
+                {
+                    return m_vecOffset;
+                }
+
+                /**
+                 * @brief Returns the bytes held by the distinct keys and the offsets.
+                 */
+                size_t bytes() const
+                {
+                    return m_vecKey.size() * sizeof(T) + m_vecOffset.size() * sizeof(size_t);
+                }
+
+                /**
+                 * @brief Returns the bytes the same rows would take as a plain array.
+                 */
+                size_t dense_bytes() const
+                {
+                    return size() * sizeof(T);
+                }
+
+                /**
+                 * @brief Finds the first row whose key is not less than the value.
+                 */
+                template <typename Compare = std::less<T>>
+                size_t lower_bound(T const & value, Compare comp = {}) const
+                {
+                    return m_vecOffset[key_lower_bound(value, comp)];
+                }
+
+                /**
+                 * @brief Finds the first row whose key is greater than the value.
+                 */
+                template <typename Compare = std::less<T>>
+                size_t upper_bound(T const & value, Compare comp = {}) const
+                {
+                    return equal_range(value, comp).second;
+                }
+
+                /**
+                 * @brief Finds the rows whose keys are equivalent to the value.
+                 *
+                 * @return std::pair<size_t, size_t> The [first, last) rows of the value's run; empty if the value is absent.
+                 */
+                template <typename Compare = std::less<T>>
+                std::pair<size_t, size_t> equal_range(T const & value, Compare comp = {}) const
+                {
+                    size_t const uKey = key_lower_bound(value, comp);
+                    // The distinct keys are unique, so the run of the value is at most the one found.
+                    bool const bFound = uKey < m_vecKey.size() && !comp(value, m_vecKey[uKey]);
+                    return { m_vecOffset[uKey], m_vecOffset[uKey + bFound] };
+                }
+            };
+
+            template <typename Range>
+            run_length_t(Range &&) -> run_length_t<std::ranges::range_value_t<Range>>;
+        }
+    }
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound and simd::details::simd_traits
+
+#include <span>             // for std::span
+#include <ranges>           // for std::ranges::contiguous_range, std::ranges::random_access_range
+#include <bit>              // for std::countr_zero
+#include <utility>          // for std::index_sequence, std::make_index_sequence
+#include <algorithm>        // for std::min, std::copy
+#include <stdexcept>        // for std::invalid_argument
+#include <type_traits>      // for std::is_same_v
+
+/**
+ * @file lower_bound_set_ops.hpp
+ * @brief Provides intersection and difference of sorted sets, such as posting lists, into caller-provided buffers.
+ *
+ * Two strategies are picked by the ratio of the input sizes:
+ * - similar sizes: a block merge that compares a register of one input against every element of a register of the other
+ *   with broadcast cmp_eq, then advances whichever block ends lower;
+ * - skewed sizes: each element of the smaller input gallops through the larger one, doubling its step until it overshoots,
+ *   and simd::lower_bound finishes inside the last step.
+ * Inputs must be strictly increasing. Nothing is allocated; the caller sizes the output.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace sets
+        {
+            /**
+             * @brief The size ratio from which the larger input is galloped through instead of merged.
+             */
+            constexpr size_t gallop_ratio_v = 32;
+
+            namespace details
+            {
+                template <typename T>
+                constexpr bool is_simd_key_v = requires { typename simd::details::simd_traits<T>::simd_type; };
+
+                template <typename T, size_t... zuLANE_i>
+                typename simd::details::simd_traits<T>::simd_type load_block(T const * const p, std::index_sequence<zuLANE_i...>)
+                {
+                    return simd::details::simd_traits<T>::setr(p[zuLANE_i]...);
+                }
+
+                /**
+                 * @brief Reports, in order, whether each element of a is also in b; for inputs of similar sizes.
+                 *
+                 * @param fnVisit Invoked with (index into a, whether a[index] is in b) for every element of a.
+                 */
+                template <typename T, typename Tvisit>
+                void merge_membership(std::span<T const> const a, std::span<T const> const b, Tvisit && fnVisit)
+                {
+                    size_t uA = 0;
+                    size_t uB = 0;
+                    // Lanes of the current block of a matched by earlier blocks of b.
+                    unsigned uMatched = 0;
+
+                    if constexpr (is_simd_key_v<T>)
+                    {
+                        using traits_type = simd::details::simd_traits<T>;
+                        constexpr size_t simd_size_v = traits_type::simd_size_v;
+
+                        while (uA + simd_size_v <= a.size() && uB + simd_size_v <= b.size())
+                        {
+                            auto const simdA = load_block(a.data() + uA, std::make_index_sequence<simd_size_v>{});
+                            for (size_t j = 0; j < simd_size_v; ++j)
+                            {
+                                uMatched |= static_cast<unsigned>(traits_type::cmp_eq(simdA, traits_type::set1(b[uB + j])));
+                            }
+                            T const tLastA = a[uA + simd_size_v - 1];
+                            T const tLastB = b[uB + simd_size_v - 1];
+                            if (!(tLastB < tLastA))
+                            {
+                                // Every later element of b is greater than this block of a: retire it.
+                                for (size_t i = 0; i < simd_size_v; ++i)
+                                {
+                                    fnVisit(uA + i, ((uMatched >> i) & 1) != 0);
+                                }
+                                uA += simd_size_v;
+                                uMatched = 0;
+                            }
+                            if (!(tLastA < tLastB))
+                            {
+                                uB += simd_size_v;
+                            }
+                        }
+                    }
+
+                    // Scalar merge of the tails; lanes of a partially compared block keep their earlier matches.
+                    size_t const uBlock = uA;
+                    for (; uA < a.size(); ++uA)
+                    {
+                        while (uB < b.size() && b[uB] < a[uA])
+                        {
+                            ++uB;
+                        }
+                        bool const bMatchedBefore = (uA - uBlock < 32) && ((uMatched >> (uA - uBlock)) & 1);
+                        fnVisit(uA, bMatchedBefore || (uB < b.size() && !(a[uA] < b[uB])));
+                    }
+                }
+
+                /**
+                 * @brief Finds the lower bound of a value in large at or after a cursor by galloping, then simd::lower_bound.
+                 */
+                template <typename T>
+                size_t gallop(std::span<T const> const large, size_t const uFrom, T const & tValue)
+                {
+                    size_t uStep = 1;
+                    while (uFrom + uStep < large.size() && large[uFrom + uStep] < tValue)
+                    {
+                        uStep *= 2;
+                    }
+                    size_t const uFirst = uFrom + uStep / 2;
+                    size_t const uLast = std::min(uFrom + uStep + 1, large.size());
+                    std::span<T const> const spanWindow = large.subspan(uFirst, uLast - uFirst);
+                    return uFirst + static_cast<size_t>(simd::lower_bound(spanWindow, tValue) - spanWindow.begin());
+                }
+
+                /**
+                 * @brief Reports, in order, whether each element of small is also in large; for skewed sizes.
+                 */
+                template <typename T, typename Tvisit>
+                void gallop_membership(std::span<T const> const small, std::span<T const> const large, Tvisit && fnVisit)
+                {
+                    size_t uCursor = 0;
+                    for (size_t i = 0; i < small.size(); ++i)
+                    {
+                        if (uCursor < large.size())
+                        {
+                            uCursor = gallop(large, uCursor, small[i]);
+                        }
+                        fnVisit(i, uCursor < large.size() && !(small[i] < large[uCursor]));
+                    }
+                }
+
+                template <typename T, typename Tvisit>
+                void membership(std::span<T const> const a, std::span<T const> const b, Tvisit && fnVisit)
+                {
+                    if (b.size() >= a.size() * gallop_ratio_v)
+                    {
+                        gallop_membership(a, b, fnVisit);
+                    }
+                    else
+                    {
+                        merge_membership(a, b, fnVisit);
+                    }
+                }
+
+                template <typename Range>
+                auto as_span(Range const & r)
+                {
+                    return std::span<std::ranges::range_value_t<Range> const>(std::ranges::data(r), std::ranges::size(r));
+                }
+            }
+
+            /**
+             * @brief Writes the elements common to two strictly increasing ranges into out.
+             *
+             * @param a The first range.
+             * @param b The second range.
+             * @param out The output buffer; must hold at least min(size(a), size(b)) elements.
+             * @return size_t The number of elements written.
+             *
+             * @example
+             * std::vector<uint32_t> a = {1, 3, 5, 7}, b = {3, 4, 5};
+             * std::vector<uint32_t> out(3);
+             * size_t n = jrmwng::algorithm::sets::intersect(a, b, out); // 2: {3, 5}
+             */
+            template <typename RangeA, typename RangeB, typename Output>
+            requires std::ranges::contiguous_range<RangeA> && std::ranges::contiguous_range<RangeB> && std::ranges::random_access_range<Output>
+            size_t intersect(RangeA const & a, RangeB const & b, Output && out)
+            {
+                static_assert(std::is_same_v<std::ranges::range_value_t<RangeA>, std::ranges::range_value_t<RangeB>>, "Ranges must have the same element type");
+
+                auto const spanA = details::as_span(a);
+                auto const spanB = details::as_span(b);
+                auto const spanSmall = (spanA.size() <= spanB.size()) ? spanA : spanB;
+                auto const spanLarge = (spanA.size() <= spanB.size()) ? spanB : spanA;
+                if (static_cast<size_t>(std::ranges::size(out)) < spanSmall.size())
+                {
+                    throw std::invalid_argument("intersect: the output is shorter than the smaller input");
+                }
+
+                auto const itOut = std::ranges::begin(out);
+                size_t uCount = 0;
+                details::membership(spanSmall, spanLarge, [&](size_t const i, bool const bIn)
+                {
+                    if (bIn)
+                    {
+                        itOut[uCount++] = spanSmall[i];
+                    }
+                });
+                return uCount;
+            }
+
+            /**
+             * @brief Counts the elements common to two strictly increasing ranges.
+             */
+            template <typename RangeA, typename RangeB>
+            requires std::ranges::contiguous_range<RangeA> && std::ranges::contiguous_range<RangeB>
+            size_t count_intersection(RangeA const & a, RangeB const & b)
+            {
+                static_assert(std::is_same_v<std::ranges::range_value_t<RangeA>, std::ranges::range_value_t<RangeB>>, "Ranges must have the same element type");
+
+                auto const spanA = details::as_span(a);
+                auto const spanB = details::as_span(b);
+                size_t uCount = 0;
+                details::membership((spanA.size() <= spanB.size()) ? spanA : spanB, (spanA.size() <= spanB.size()) ? spanB : spanA, [&](size_t, bool const bIn)
+                {
+                    uCount += bIn;
+                });
+                return uCount;
+            }
+
+            /**
+             * @brief Writes the elements of a that are not in b into out; both ranges strictly increasing.
+             *
+             * @param a The range to take elements from.
+             * @param b The range of elements to remove.
+             * @param out The output buffer; must hold at least size(a) elements.
+             * @return size_t The number of elements written.
+             */
+            template <typename RangeA, typename RangeB, typename Output>
+            requires std::ranges::contiguous_range<RangeA> && std::ranges::contiguous_range<RangeB> && std::ranges::random_access_range<Output>
+            size_t difference(RangeA const & a, RangeB const & b, Output && out)
+            {
+                static_assert(std::is_same_v<std::ranges::range_value_t<RangeA>, std::ranges::range_value_t<RangeB>>, "Ranges must have the same element type");
+
+                auto const spanA = details::as_span(a);
+                auto const spanB = details::as_span(b);
+                if (static_cast<size_t>(std::ranges::size(out)) < spanA.size())
+                {
+                    throw std::invalid_argument("difference: the output is shorter than the first input");
+                }
+
+                auto const itOut = std::ranges::begin(out);
+                size_t uCount = 0;
+                if (spanA.size() >= spanB.size() * gallop_ratio_v)
+                {
+                    // Gallop the few removals through a, copying the runs of a between them.
+                    size_t uCopied = 0;
+                    for (auto const & tRemove : spanB)
+                    {
+                        if (uCopied >= spanA.size())
+                        {
+                            break;
+                        }
+                        size_t const uFound = details::gallop(spanA, uCopied, tRemove);
+                        std::copy(spanA.begin() + uCopied, spanA.begin() + uFound, itOut + uCount);
+                        uCount += uFound - uCopied;
+                        uCopied = (uFound < spanA.size() && !(tRemove < spanA[uFound])) ? uFound + 1 : uFound;
+                    }
+                    std::copy(spanA.begin() + uCopied, spanA.end(), itOut + uCount);
+                    return uCount + (spanA.size() - uCopied);
+                }
+                details::membership(spanA, spanB, [&](size_t const i, bool const bIn)
+                {
+                    if (!bIn)
+                    {
+                        itOut[uCount++] = spanA[i];
+                    }
+                });
+                return uCount;
+            }
+        }
+    }
+}
@@ -2,19 +2,35 @@
 
 #include "lower_bound.hpp"  // Project-specific header for lower_bound functionality
 
+#if !defined(JRMWNG_ALGORITHM_SIMD_PORTABLE) && !defined(__AVX2__)
+#define JRMWNG_ALGORITHM_SIMD_PORTABLE
+#endif
+
+#if defined(JRMWNG_ALGORITHM_SIMD_PORTABLE)
+#include "lower_bound_simd_portable.hpp" // Project-specific header for simd::portable::simd_traits_base
+#else
 #include <immintrin.h>      // for __m256, __m256i, __m256d and associated intrinsics
+#endif
 #include <utility>          // for std::make_index_sequence, std::index_sequence
 #include <functional>       // for std::invoke, std::less, std::less_equal, std::greater, std::greater_equal, std::identity
-#include <type_traits>      // for std::is_invocable_v, std::is_invocable_r_v
-#include <ranges>           // for std::ranges::forward_range, std::ranges::iterator_t
-#include <cstdint>          // for int64_t
+#include <type_traits>      // for std::is_invocable_v, std::invoke_result_t, std::remove_cvref_t
+#include <concepts>         // for std::convertible_to
+#include <ranges>           // for std::ranges::forward_range, std::ranges::iterator_t, std::ranges::range_value_t
+#include <cstdint>          // for int64_t, uint32_t, uint64_t, INT32_MIN, INT64_MIN
 
 /**
  * @file lower_bound_simd.hpp
  * @brief Provides SIMD-optimized implementations of the lower_bound algorithm for different data types.
  * 
  * This file contains template functions and specializations to find the first position in a sorted range where a given value could be inserted without violating the order.
- * It includes SIMD-optimized versions for float, double, and int types.
+ * It includes SIMD-optimized versions for float, double, int, int64_t, uint32_t and uint64_t types.
+ *
+ * The simd_traits specializations are written with AVX2 intrinsics when __AVX2__ is defined. Otherwise, or when
+ * JRMWNG_ALGORITHM_SIMD_PORTABLE is defined, they come from the portable backend in lower_bound_simd_portable.hpp.
+ * Code outside the specializations only names vectors as simd_traits<T>::simd_type, so it compiles with either backend.
+ *
+ * Argument types without a SIMD form fall back to a scalar search. dispatch_v reports, at compile time, which engine a
+ * combination of argument types gets; defining JRMWNG_ALGORITHM_SIMD_STRICT turns every fallback into a compile error.
  */
 
 namespace jrmwng
@@ -33,6 +49,32 @@ namespace jrmwng
                 template <typename T>
                 struct simd_traits;
 
+#if defined(JRMWNG_ALGORITHM_SIMD_PORTABLE)
+                template <>
+                struct simd_traits<float> : portable::simd_traits_base<float, 8>
+                {
+                };
+                template <>
+                struct simd_traits<double> : portable::simd_traits_base<double, 4>
+                {
+                };
+                template <>
+                struct simd_traits<int> : portable::simd_traits_base<int, 8>
+                {
+                };
+                template <>
+                struct simd_traits<int64_t> : portable::simd_traits_base<int64_t, 4>
+                {
+                };
+                template <>
+                struct simd_traits<uint32_t> : portable::simd_traits_base<uint32_t, 8>
+                {
+                };
+                template <>
+                struct simd_traits<uint64_t> : portable::simd_traits_base<uint64_t, 4>
+                {
+                };
+#else
                 /**
                  * @brief Specialization of simd_traits for float type.
                  */
@@ -67,6 +109,10 @@ namespace jrmwng
                     {
                         return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ));
                     }
+                    static int cmp_eq(__m256 const &lhs, __m256 const &rhs)
+                    {
+                        return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ));
+                    }
                     template <int nINDEX>
                     static float extract(__m256 const &lhs)
                     {
@@ -111,6 +157,10 @@ namespace jrmwng
                     {
                         return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_GE_OQ));
                     }
+                    static int cmp_eq(__m256d const &lhs, __m256d const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ));
+                    }
                     template <int nINDEX>
                     static double extract(__m256d const &lhs)
                     {
@@ -145,7 +195,7 @@ namespace jrmwng
                     }
                     static int cmp_le(__m256i const &lhs, __m256i const &rhs)
                     {
-                        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(rhs, lhs)));
+                        return ~cmp_gt(lhs, rhs) & 0xFF;
                     }
                     static int cmp_gt(__m256i const &lhs, __m256i const &rhs)
                     {
@@ -153,7 +203,11 @@ namespace jrmwng
                     }
                     static int cmp_ge(__m256i const &lhs, __m256i const &rhs)
                     {
-                        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(lhs, rhs)));
+                        return ~cmp_lt(lhs, rhs) & 0xFF;
+                    }
+                    static int cmp_eq(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
                     }
                     template <int nINDEX>
                     static int extract(__m256i const &lhs)
@@ -161,7 +215,173 @@ namespace jrmwng
                         return _mm256_extract_epi32(lhs, nINDEX);
                     }
                 };
-                
+
+
+                /**
+                 * @brief Specialization of simd_traits for int64_t type.
+                 */
+                template <>
+                struct simd_traits<int64_t>
+                {
+                    using simd_type = __m256i;
+                    using index_sequence_type = std::make_index_sequence<4>;
+                    constexpr static size_t simd_size_v = 4;
+
+                    static __m256i set1(int64_t const nValue)
+                    {
+                        return _mm256_set1_epi64x(nValue);
+                    }
+                    static __m256i setr(int64_t const n0, int64_t const n1, int64_t const n2, int64_t const n3)
+                    {
+                        return _mm256_setr_epi64x(n0, n1, n2, n3);
+                    }
+                    static int cmp_lt(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(rhs, lhs)));
+                    }
+                    static int cmp_le(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return ~cmp_gt(lhs, rhs) & 0xF;
+                    }
+                    static int cmp_gt(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(lhs, rhs)));
+                    }
+                    static int cmp_ge(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return ~cmp_lt(lhs, rhs) & 0xF;
+                    }
+                    static int cmp_eq(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs)));
+                    }
+                    template <int nINDEX>
+                    static int64_t extract(__m256i const &lhs)
+                    {
+                        return _mm256_extract_epi64(lhs, nINDEX);
+                    }
+                };
+
+                /**
+                 * @brief Specialization of simd_traits for uint32_t type.
+                 * 
+                 * AVX2 only compares signed integers, so both operands are biased by the sign bit first.
+                 */
+                template <>
+                struct simd_traits<uint32_t>
+                {
+                    using simd_type = __m256i;
+                    using index_sequence_type = std::make_index_sequence<8>;
+                    constexpr static size_t simd_size_v = 8;
+
+                    static __m256i bias(__m256i const &v)
+                    {
+                        return _mm256_xor_si256(v, _mm256_set1_epi32(INT32_MIN));
+                    }
+                    static __m256i set1(uint32_t const uValue)
+                    {
+                        return _mm256_set1_epi32(static_cast<int>(uValue));
+                    }
+                    static __m256i setr(uint32_t const u0, uint32_t const u1, uint32_t const u2, uint32_t const u3, uint32_t const u4, uint32_t const u5, uint32_t const u6, uint32_t const u7)
+                    {
+                        return _mm256_setr_epi32(static_cast<int>(u0), static_cast<int>(u1), static_cast<int>(u2), static_cast<int>(u3), static_cast<int>(u4), static_cast<int>(u5), static_cast<int>(u6), static_cast<int>(u7));
+                    }
+                    static int cmp_lt(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(bias(rhs), bias(lhs))));
+                    }
+                    static int cmp_le(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return ~cmp_gt(lhs, rhs) & 0xFF;
+                    }
+                    static int cmp_gt(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(bias(lhs), bias(rhs))));
+                    }
+                    static int cmp_ge(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return ~cmp_lt(lhs, rhs) & 0xFF;
+                    }
+                    static int cmp_eq(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
+                    }
+                    template <int nINDEX>
+                    static uint32_t extract(__m256i const &lhs)
+                    {
+                        return static_cast<uint32_t>(_mm256_extract_epi32(lhs, nINDEX));
+                    }
+                };
+
+                /**
+                 * @brief Specialization of simd_traits for uint64_t type.
+                 * 
+                 * AVX2 only compares signed integers, so both operands are biased by the sign bit first.
+                 */
+                template <>
+                struct simd_traits<uint64_t>
+                {
+                    using simd_type = __m256i;
+                    using index_sequence_type = std::make_index_sequence<4>;
+                    constexpr static size_t simd_size_v = 4;
+
+                    static __m256i bias(__m256i const &v)
+                    {
+                        return _mm256_xor_si256(v, _mm256_set1_epi64x(INT64_MIN));
+                    }
+                    static __m256i set1(uint64_t const uValue)
+                    {
+                        return _mm256_set1_epi64x(static_cast<int64_t>(uValue));
+                    }
+                    static __m256i setr(uint64_t const u0, uint64_t const u1, uint64_t const u2, uint64_t const u3)
+                    {
+                        return _mm256_setr_epi64x(static_cast<int64_t>(u0), static_cast<int64_t>(u1), static_cast<int64_t>(u2), static_cast<int64_t>(u3));
+                    }
+                    static int cmp_lt(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(bias(rhs), bias(lhs))));
+                    }
+                    static int cmp_le(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return ~cmp_gt(lhs, rhs) & 0xF;
+                    }
+                    static int cmp_gt(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(bias(lhs), bias(rhs))));
+                    }
+                    static int cmp_ge(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return ~cmp_lt(lhs, rhs) & 0xF;
+                    }
+                    static int cmp_eq(__m256i const &lhs, __m256i const &rhs)
+                    {
+                        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs)));
+                    }
+                    template <int nINDEX>
+                    static uint64_t extract(__m256i const &lhs)
+                    {
+                        return static_cast<uint64_t>(_mm256_extract_epi64(lhs, nINDEX));
+                    }
+                };
+#endif
+
+                /**
+                 * @brief Whether a function accepts a SIMD vector of T, and whether it compares two of them into a lane mask.
+                 *
+                 * Requires-expressions rather than std::is_invocable_v: GCC drops the attributes of intrinsic vector types such as
+                 * __m256 when they are template arguments, and warns about it with -Wignored-attributes.
+                 */
+                template <typename Tfn, typename T>
+                constexpr bool accepts_simd_v = requires (Tfn const & fn, typename simd_traits<T>::simd_type const & simd)
+                {
+                    std::invoke(fn, simd);
+                };
+                template <typename Tfn, typename T>
+                constexpr bool compares_simd_v = requires (Tfn const & fn, typename simd_traits<T>::simd_type const & simd)
+                {
+                    { std::invoke(fn, simd, simd) } -> std::convertible_to<int>;
+                };
+
                 /**
                  * @brief Comparison function for SIMD types.
                  * 
@@ -202,13 +422,13 @@ namespace jrmwng
                     int apply(simd_type const &lhs, T const &tRHS, std::index_sequence<zuELEMENT_i...>) const
                     {
                         return
-                            ((std::invoke(compare, simd_traits<T>::extract<zuELEMENT_i>(lhs), tRHS) ? (0x01 << zuELEMENT_i) : 0) | ... | 0);
+                            ((std::invoke(compare, simd_traits<T>::template extract<zuELEMENT_i>(lhs), tRHS) ? (0x01 << zuELEMENT_i) : 0) | ... | 0);
                     }
 
                     /**
                      * @brief Checks if the comparison function can be applied to SIMD types.
                      */
-                    constexpr static bool is_simd_compare_v = std::is_invocable_r_v<int, Tcompare, simd_type, simd_type>
+                    constexpr static bool is_simd_compare_v = compares_simd_v<Tcompare, T>
                         || std::is_same_v<Tcompare, std::less<T>>
                         || std::is_same_v<Tcompare, std::less_equal<T>>
                         || std::is_same_v<Tcompare, std::greater<T>>
@@ -225,7 +445,7 @@ namespace jrmwng
                     {
                         if constexpr (is_simd_compare_v)
                         {
-                            if constexpr (std::is_invocable_r_v<int, Tcompare, simd_type, simd_type>)
+                            if constexpr (compares_simd_v<Tcompare, T>)
                             {
                                 return std::invoke(compare, lhs, simd_traits<T>::set1(tRHS));
                             }
@@ -247,7 +467,7 @@ namespace jrmwng
                             }
                             else
                             {
-                                static_assert(false, "Inconsistent `is_simd_compare_v`");
+                                static_assert(!is_simd_compare_v, "Inconsistent `is_simd_compare_v`");
                             }
                         }
                         else
@@ -269,7 +489,7 @@ namespace jrmwng
                     template <typename... Ts, size_t zuOFFSET, size_t... zuELEMENT_i>
                     int apply(std::tuple<Ts...> const &tupleLHS, T const &tRHS, std::integral_constant<size_t, zuOFFSET>, std::index_sequence<zuELEMENT_i...>) const
                     {
-                        if constexpr (std::is_same_v<std::index_sequence<zuELEMENT_i...>, std::make_index_sequence<8>> && is_simd_compare_v)
+                        if constexpr (std::is_same_v<std::index_sequence<zuELEMENT_i...>, typename simd_traits<T>::index_sequence_type> && is_simd_compare_v)
                         {
                             return operator()(simd_traits<T>::setr(std::get<zuOFFSET + zuELEMENT_i>(tupleLHS)...), tRHS) << zuOFFSET;
                         }
@@ -328,17 +548,29 @@ namespace jrmwng
                         {
                             return std::invoke(projection, args...);
                         }
-                        else if constexpr (sizeof...(Targs) == 8 && (std::is_same_v<Targs, float> && ... && true) && std::is_invocable_v<Tprojection, __m256>)
+                        else if constexpr (sizeof...(Targs) == 8 && (std::is_same_v<Targs, float> && ... && true) && accepts_simd_v<Tprojection, float>)
+                        {
+                            return std::invoke(projection, simd_traits<float>::setr(args...));
+                        }
+                        else if constexpr (sizeof...(Targs) == 8 && (std::is_same_v<Targs, int> && ... && true) && accepts_simd_v<Tprojection, int>)
                         {
-                            return std::invoke(projection, _mm256_setr_ps(args...));
+                            return std::invoke(projection, simd_traits<int>::setr(args...));
                         }
-                        else if constexpr (sizeof...(Targs) == 8 && (std::is_same_v<Targs, int> && ... && true) && std::is_invocable_v<Tprojection, __m256i>)
+                        else if constexpr (sizeof...(Targs) == 4 && (std::is_same_v<Targs, double> && ... && true) && accepts_simd_v<Tprojection, double>)
                         {
-                            return std::invoke(projection, _mm256_setr_epi32(args...));
+                            return std::invoke(projection, simd_traits<double>::setr(args...));
                         }
-                        else if constexpr (sizeof...(Targs) == 4 && (std::is_same_v<Targs, double> && ... && true) && std::is_invocable_v<Tprojection, __m256d>)
+                        else if constexpr (sizeof...(Targs) == 8 && (std::is_same_v<Targs, uint32_t> && ... && true) && accepts_simd_v<Tprojection, uint32_t>)
                         {
-                            return std::invoke(projection, _mm256_setr_pd(args...));
+                            return std::invoke(projection, simd_traits<uint32_t>::setr(args...));
+                        }
+                        else if constexpr (sizeof...(Targs) == 4 && (std::is_same_v<Targs, int64_t> && ... && true) && accepts_simd_v<Tprojection, int64_t>)
+                        {
+                            return std::invoke(projection, simd_traits<int64_t>::setr(args...));
+                        }
+                        else if constexpr (sizeof...(Targs) == 4 && (std::is_same_v<Targs, uint64_t> && ... && true) && accepts_simd_v<Tprojection, uint64_t>)
+                        {
+                            return std::invoke(projection, simd_traits<uint64_t>::setr(args...));
                         }
                         else
                         {
@@ -348,9 +580,89 @@ namespace jrmwng
                 };
             }
 
+            /**
+             * @brief The engines simd::lower_bound can dispatch to.
+             */
+            enum class engine_kind
+            {
+                scalar, // Binary search with the comparison function, one key per step.
+                lanes,  // N-ary search whose N keys are compared one at a time, e.g. by a comparison function without a SIMD form.
+                vector, // N-ary search whose N keys are compared in one SIMD instruction.
+            };
+
+            /**
+             * @brief The engine and fan-out simd::lower_bound uses for a combination of argument types.
+             */
+            struct dispatch_info
+            {
+                engine_kind engine;
+                size_t fanout;
+            };
+
+            namespace details
+            {
+                /**
+                 * @brief Whether simd_traits is specialized for T.
+                 */
+                template <typename T>
+                constexpr bool is_simd_key_v = requires { simd_traits<T>::simd_size_v; };
+
+                /**
+                 * @brief Whether the projected keys of a range reach the comparison as T: keys of type T projected as SIMD vectors,
+                 * or keys projected one at a time to T.
+                 *
+                 * A projection of single keys must return T itself, so that keys of another type, e.g. int64_t keys searched
+                 * with an int value, are reported as a fallback rather than silently converted into lanes of T.
+                 */
+                template <typename Tinput, typename T, typename Projection, size_t... zuLANE_i>
+                constexpr bool is_lane_projection(std::index_sequence<zuLANE_i...>)
+                {
+                    if constexpr (std::is_same_v<Tinput, T> && accepts_simd_v<Projection, T>)
+                    {
+                        return true;
+                    }
+                    else if constexpr (std::is_invocable_v<Projection, Tinput>)
+                    {
+                        return std::is_same_v<std::remove_cvref_t<std::invoke_result_t<Projection, Tinput>>, T>;
+                    }
+                    else
+                    {
+                        return std::is_invocable_v<Projection, decltype(zuLANE_i, std::declval<Tinput>())...>;
+                    }
+                }
+
+                template <typename Range, typename T, typename Compare, typename Projection>
+                constexpr dispatch_info dispatch()
+                {
+                    if constexpr (is_simd_key_v<T>)
+                    {
+                        constexpr size_t simd_size_v = simd_traits<T>::simd_size_v;
+                        if constexpr (is_lane_projection<std::ranges::range_value_t<Range>, T, Projection>(std::make_index_sequence<simd_size_v>{}))
+                        {
+                            return { simd_compare_t<Compare, T>::is_simd_compare_v ? engine_kind::vector : engine_kind::lanes, simd_size_v };
+                        }
+                    }
+                    return { engine_kind::scalar, 1 };
+                }
+            }
+
+            /**
+             * @brief Reports the engine simd::lower_bound uses for a range, value, comparison and projection type.
+             *
+             * @example
+             * static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<int>, int>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+             * static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<long>, int>.engine == jrmwng::algorithm::simd::engine_kind::scalar);
+             */
+            template <typename Range, typename T, typename Compare = std::less<T>, typename Projection = std::identity>
+            constexpr dispatch_info dispatch_v = details::dispatch<std::remove_cvref_t<Range>, T, Compare, Projection>();
+
             /**
              * @brief Finds the first position in a sorted range where a given value could be inserted without violating the order.
              * 
+             * Keys of a type with SIMD support, reaching the comparison as that type, are searched N-ary with N the keys of one
+             * SIMD vector; dispatch_v reports the engine picked. With JRMWNG_ALGORITHM_SIMD_STRICT defined, any engine but
+             * engine_kind::vector is a compile error; strict::lower_bound opts single call sites in.
+             *
              * @tparam Range The type of the range.
              * @tparam T The type of the value to compare.
              * @tparam Compare The type of the comparison function.
@@ -370,54 +682,33 @@ namespace jrmwng
             requires std::ranges::forward_range<Range>
             std::ranges::iterator_t<Range> lower_bound(Range && r, T const & value, Compare comp = {}, Projection proj = {})
             {
-                using Tinput = typename std::ranges::range_value_t<Range>;
+                constexpr dispatch_info dispatch_info_v = dispatch_v<Range, T, Compare, Projection>;
+#if defined(JRMWNG_ALGORITHM_SIMD_STRICT)
+                static_assert(dispatch_info_v.engine == engine_kind::vector, "simd::lower_bound: these argument types fall back from the SIMD engine; see simd::dispatch_v");
+#endif
 
-                /**
-                 * @brief Specialization for float and int types.
-                 */
-                if constexpr (std::is_same_v<float, T> || std::is_same_v<int, T>)
+                if constexpr (dispatch_info_v.fanout > 1)
                 {
-                    if constexpr (std::is_invocable_v<Projection, Tinput, Tinput, Tinput, Tinput, Tinput, Tinput, Tinput, Tinput>)
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, details::simd_compare_t<Compare, T>{comp}, details::simd_projection_t<Projection>{proj}, std::make_index_sequence<8>{});
-                    }
-                    else if constexpr (std::is_invocable_v<Projection, __m256>)
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, details::simd_compare_t<Compare, T>{comp}, details::simd_projection_t<Projection>{proj}, std::make_index_sequence<8>{});
-                    }
-                    else if constexpr (std::is_invocable_v<Projection, __m256i>)
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, details::simd_compare_t<Compare, T>{comp}, details::simd_projection_t<Projection>{proj}, std::make_index_sequence<8>{});
-                    }
-                    else
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, comp, proj, std::make_index_sequence<1>{});
-                    }
+                    return jrmwng::algorithm::ranges::lower_bound(r, value, details::simd_compare_t<Compare, T>{comp}, details::simd_projection_t<Projection>{proj}, std::make_index_sequence<dispatch_info_v.fanout>{});
                 }
-                /**
-                 * @brief Specialization for double type.
-                 */
-                else if constexpr (std::is_same_v<double, T>)
+                else
                 {
-                    if constexpr (std::is_invocable_v<Projection, Tinput, Tinput, Tinput, Tinput>)
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, details::simd_compare_t<Compare, T>{comp}, details::simd_projection_t<Projection>{proj}, std::make_index_sequence<4>{});
-                    }
-                    else if constexpr (std::is_invocable_v<Projection, __m256d>)
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, details::simd_compare_t<Compare, T>{comp}, details::simd_projection_t<Projection>{proj}, std::make_index_sequence<4>{});
-                    }
-                    else
-                    {
-                        return jrmwng::algorithm::ranges::lower_bound(r, value, comp, proj, std::make_index_sequence<1>{});
-                    }
+                    return jrmwng::algorithm::ranges::lower_bound(r, value, comp, proj, std::make_index_sequence<1>{});
                 }
+            }
+
+            namespace strict
+            {
                 /**
-                 * @brief Default case for other types.
+                 * @brief simd::lower_bound, only for argument types it compares with SIMD instructions.
+                 *
+                 * Other argument types do not satisfy the constraint, so a call site meant to be vectorized cannot silently fall back.
                  */
-                else
+                template <typename Range, typename T, typename Compare = std::less<T>, typename Projection = std::identity>
+                requires std::ranges::forward_range<Range> && (dispatch_v<Range, T, Compare, Projection>.engine == engine_kind::vector)
+                std::ranges::iterator_t<Range> lower_bound(Range && r, T const & value, Compare comp = {}, Projection proj = {})
                 {
-                    return jrmwng::algorithm::ranges::lower_bound(r, value, comp, proj, std::make_index_sequence<1>{});
+                    return simd::lower_bound(std::forward<Range>(r), value, comp, proj);
                 }
             }
 
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>            // for std::array
+#include <cstddef>          // for size_t
+#include <type_traits>      // for std::integral_constant, std::is_invocable_v
+#include <utility>          // for std::index_sequence, std::make_index_sequence
+
+#if __has_include(<experimental/simd>) && !defined(JRMWNG_ALGORITHM_SIMD_EMULATED)
+#include <experimental/simd> // for std::experimental::fixed_size_simd
+#endif
+
+/**
+ * @file lower_bound_simd_portable.hpp
+ * @brief Provides the portable backend of simd_traits, for targets without AVX2.
+ *
+ * lower_bound_simd.hpp selects this backend when JRMWNG_ALGORITHM_SIMD_PORTABLE is defined, or when __AVX2__ is not.
+ * The vectors are std::experimental::fixed_size_simd where the standard library provides it (GCC 11 and later, on any
+ * target it supports, e.g. NEON on AArch64). Otherwise, or when JRMWNG_ALGORITHM_SIMD_EMULATED is defined, they are
+ * emulated_simd_t, a fixed-size array with element-wise operators that the compiler may auto-vectorize. Both keep the
+ * lane counts of the AVX2 backend, so every caller picks the same fan-out on every target.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace simd
+        {
+            namespace portable
+            {
+                /**
+                 * @brief Element-wise emulation of a fixed-size SIMD vector.
+                 *
+                 * @tparam T The type of the lanes.
+                 * @tparam zuSIZE The number of lanes.
+                 */
+                template <typename T, size_t zuSIZE>
+                struct emulated_simd_t
+                {
+                    using mask_type = std::array<bool, zuSIZE>;
+
+                    std::array<T, zuSIZE> lanes;
+
+                    emulated_simd_t() = default;
+
+                    /**
+                     * @brief Broadcasts a value to every lane.
+                     */
+                    explicit emulated_simd_t(T const tValue)
+                    {
+                        lanes.fill(tValue);
+                    }
+
+                    /**
+                     * @brief Sets lane i to fnGenerate(std::integral_constant<size_t, i>), as std::experimental::simd does.
+                     */
+                    template <typename Tgenerator>
+                    requires std::is_invocable_v<Tgenerator, std::integral_constant<size_t, 0>>
+                    explicit emulated_simd_t(Tgenerator && fnGenerate)
+                    {
+                        [&]<size_t... zuLANE_i>(std::index_sequence<zuLANE_i...>)
+                        {
+                            ((lanes[zuLANE_i] = static_cast<T>(fnGenerate(std::integral_constant<size_t, zuLANE_i>{}))), ...);
+                        }(std::make_index_sequence<zuSIZE>{});
+                    }
+
+                    T operator[](size_t const uLane) const
+                    {
+                        return lanes[uLane];
+                    }
+
+                    template <typename Tpredicate>
+                    friend mask_type compare(emulated_simd_t const & lhs, emulated_simd_t const & rhs, Tpredicate fnPredicate)
+                    {
+                        mask_type aMask;
+                        for (size_t i = 0; i < zuSIZE; ++i)
+                        {
+                            aMask[i] = fnPredicate(lhs.lanes[i], rhs.lanes[i]);
+                        }
+                        return aMask;
+                    }
+                    friend mask_type operator<(emulated_simd_t const & lhs, emulated_simd_t const & rhs)
+                    {
+                        return compare(lhs, rhs, [](T const a, T const b) { return a < b; });
+                    }
+                    friend mask_type operator<=(emulated_simd_t const & lhs, emulated_simd_t const & rhs)
+                    {
+                        return compare(lhs, rhs, [](T const a, T const b) { return a <= b; });
+                    }
+                    friend mask_type operator>(emulated_simd_t const & lhs, emulated_simd_t const & rhs)
+                    {
+                        return compare(lhs, rhs, [](T const a, T const b) { return a > b; });
+                    }
+                    friend mask_type operator>=(emulated_simd_t const & lhs, emulated_simd_t const & rhs)
+                    {
+                        return compare(lhs, rhs, [](T const a, T const b) { return a >= b; });
+                    }
+                    friend mask_type operator==(emulated_simd_t const & lhs, emulated_simd_t const & rhs)
+                    {
+                        return compare(lhs, rhs, [](T const a, T const b) { return a == b; });
+                    }
+                };
+
+#if __has_include(<experimental/simd>) && !defined(JRMWNG_ALGORITHM_SIMD_EMULATED)
+                template <typename T, size_t zuSIZE>
+                using vector_t = std::experimental::fixed_size_simd<T, static_cast<int>(zuSIZE)>;
+
+                constexpr bool is_emulated_v = false;
+#else
+                template <typename T, size_t zuSIZE>
+                using vector_t = emulated_simd_t<T, zuSIZE>;
+
+                constexpr bool is_emulated_v = true;
+#endif
+
+                /**
+                 * @brief simd_traits implemented on vector_t, with the interface of the AVX2 specializations.
+                 *
+                 * @tparam T The type of the lanes.
+                 * @tparam zuSIZE The number of lanes.
+                 */
+                template <typename T, size_t zuSIZE>
+                struct simd_traits_base
+                {
+                    using simd_type = vector_t<T, zuSIZE>;
+                    using index_sequence_type = std::make_index_sequence<zuSIZE>;
+                    constexpr static size_t simd_size_v = zuSIZE;
+
+                    /**
+                     * @brief Packs a lane mask into an int, lane i in bit i, as movemask does.
+                     */
+                    template <typename Tmask>
+                    static int to_bits(Tmask const & mask)
+                    {
+                        int nBits = 0;
+                        for (size_t i = 0; i < zuSIZE; ++i)
+                        {
+                            nBits |= mask[i] ? (1 << i) : 0;
+                        }
+                        return nBits;
+                    }
+
+                    static simd_type set1(T const tValue)
+                    {
+                        return simd_type(tValue);
+                    }
+                    template <typename... Ts>
+                    requires (sizeof...(Ts) == zuSIZE)
+                    static simd_type setr(Ts const... tValue)
+                    {
+                        std::array<T, zuSIZE> const aValue{ static_cast<T>(tValue)... };
+                        return simd_type([&](auto const i) { return aValue[i]; });
+                    }
+                    static int cmp_lt(simd_type const & lhs, simd_type const & rhs)
+                    {
+                        return to_bits(lhs < rhs);
+                    }
+                    static int cmp_le(simd_type const & lhs, simd_type const & rhs)
+                    {
+                        return to_bits(lhs <= rhs);
+                    }
+                    static int cmp_gt(simd_type const & lhs, simd_type const & rhs)
+                    {
+                        return to_bits(lhs > rhs);
+                    }
+                    static int cmp_ge(simd_type const & lhs, simd_type const & rhs)
+                    {
+                        return to_bits(lhs >= rhs);
+                    }
+                    static int cmp_eq(simd_type const & lhs, simd_type const & rhs)
+                    {
+                        return to_bits(lhs == rhs);
+                    }
+                    template <int nINDEX>
+                    static T extract(simd_type const & lhs)
+                    {
+                        return lhs[nINDEX];
+                    }
+                };
+            }
+        }
+    }
+}
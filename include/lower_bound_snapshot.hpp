@@ -0,0 +1,282 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+
+#include <atomic>           // for std::atomic
+#include <array>            // for std::array
+#include <vector>           // for std::vector
+#include <set>              // for std::multiset
+#include <mutex>            // for std::mutex, std::lock_guard
+#include <future>           // for std::async, std::future
+#include <thread>           // for std::this_thread::get_id
+#include <algorithm>        // for std::min
+#include <functional>       // for std::invoke, std::less, std::identity
+#include <utility>          // for std::move, std::exchange
+#include <cstdint>          // for uint64_t
+#include <limits>           // for std::numeric_limits
+
+/**
+ * @file lower_bound_snapshot.hpp
+ * @brief Provides a read-mostly container whose readers search an immutable snapshot without waiting on writers.
+ *
+ * Readers pin the current version through epoch-based reclamation: entering a read stores the global epoch into a reader slot,
+ * which is a single compare-and-swap and never waits on a writer. A writer builds the next version (possibly in the background),
+ * publishes it with one atomic pointer exchange and reclaims old versions once every reader has moved past their retire epoch.
+ * Reads beyond the number of reader slots, e.g. many long-lived reader_t objects or nested reads, do not spin: they register
+ * their epoch in an overflow list under the writer mutex instead, which is bounded but no longer lock-free.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace concurrent
+        {
+            /**
+             * @brief A container published as a sequence of immutable snapshots.
+             *
+             * @tparam Container The type of the sorted array or prebuilt layout, e.g. std::vector<int>, or memory::huge_page_vector<int>
+             * to back every snapshot with huge pages.
+             * @tparam zuREADER_SLOTS The number of reader slots, i.e. the number of reads that can be in flight lock-free at once.
+             *
+             * @example
+             * jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>> snapshot(std::vector<int>{1, 2, 4});
+             * size_t pos = snapshot.lower_bound(3);                         // reader, lock-free while a slot is free
+             * snapshot.publish(std::vector<int>{1, 2, 3, 4});               // writer
+             */
+            template <typename Container, size_t zuREADER_SLOTS = 128>
+            class snapshot_t
+            {
+                constexpr static uint64_t inactive_v = std::numeric_limits<uint64_t>::max();
+
+                /**
+                 * @brief A reader slot on its own cache line, holding the epoch the reader entered at.
+                 */
+                struct alignas(64) slot_t
+                {
+                    std::atomic<uint64_t> epoch{ inactive_v };
+                };
+
+                struct retired_t
+                {
+                    Container const * version;
+                    uint64_t epoch;
+                };
+
+                std::atomic<Container const *> m_pCurrent;
+                std::atomic<uint64_t> m_uEpoch{ 0 };
+                std::array<slot_t, zuREADER_SLOTS> m_aSlot;
+
+                std::mutex m_mutexWriter;
+                std::vector<retired_t> m_vecRetired;
+                std::multiset<uint64_t> m_setOverflow;    ///< Epochs of the readers that found no free slot; guarded by the writer mutex.
+
+                /**
+                 * @brief Returns the oldest epoch any active reader entered at. The writer mutex must be held.
+                 */
+                uint64_t min_reader_epoch() const
+                {
+                    uint64_t uMin = m_setOverflow.empty() ? inactive_v : *m_setOverflow.begin();
+                    for (slot_t const & slot : m_aSlot)
+                    {
+                        uMin = std::min(uMin, slot.epoch.load(std::memory_order_seq_cst));
+                    }
+                    return uMin;
+                }
+
+                /**
+                 * @brief Frees the retired versions no reader can still hold. The writer mutex must be held.
+                 */
+                size_t reclaim_locked()
+                {
+                    uint64_t const uMinEpoch = min_reader_epoch();
+                    size_t const uBefore = m_vecRetired.size();
+                    std::erase_if(m_vecRetired, [uMinEpoch](retired_t const & retired)
+                    {
+                        if (retired.epoch <= uMinEpoch)
+                        {
+                            delete retired.version;
+                            return true;
+                        }
+                        return false;
+                    });
+                    return uBefore - m_vecRetired.size();
+                }
+
+            public:
+                /**
+                 * @brief Pins the snapshot that was current when the read began, until destroyed.
+                 */
+                class reader_t
+                {
+                    std::atomic<uint64_t> * m_pSlot;
+                    Container const * m_pVersion;
+                    snapshot_t * m_pOverflowOwner = nullptr;
+                    std::multiset<uint64_t>::iterator m_itOverflow;
+
+                public:
+                    reader_t(std::atomic<uint64_t> * pSlot, Container const * pVersion)
+                        : m_pSlot(pSlot)
+                        , m_pVersion(pVersion)
+                    {
+                    }
+                    /**
+                     * @brief Pins a version through an entry of the overflow list instead of a reader slot.
+                     */
+                    reader_t(snapshot_t * pOwner, std::multiset<uint64_t>::iterator itOverflow, Container const * pVersion)
+                        : m_pSlot(nullptr)
+                        , m_pVersion(pVersion)
+                        , m_pOverflowOwner(pOwner)
+                        , m_itOverflow(itOverflow)
+                    {
+                    }
+                    reader_t(reader_t && that) noexcept
+                        : m_pSlot(std::exchange(that.m_pSlot, nullptr))
+                        , m_pVersion(that.m_pVersion)
+                        , m_pOverflowOwner(std::exchange(that.m_pOverflowOwner, nullptr))
+                        , m_itOverflow(that.m_itOverflow)
+                    {
+                    }
+                    reader_t(reader_t const &) = delete;
+                    reader_t & operator=(reader_t const &) = delete;
+                    ~reader_t()
+                    {
+                        if (m_pSlot)
+                        {
+                            m_pSlot->store(inactive_v, std::memory_order_release);
+                        }
+                        if (m_pOverflowOwner)
+                        {
+                            std::lock_guard<std::mutex> const lock(m_pOverflowOwner->m_mutexWriter);
+                            m_pOverflowOwner->m_setOverflow.erase(m_itOverflow);
+                        }
+                    }
+
+                    Container const & operator*() const
+                    {
+                        return *m_pVersion;
+                    }
+                    Container const * operator->() const
+                    {
+                        return m_pVersion;
+                    }
+                };
+
+                explicit snapshot_t(Container initial = {})
+                    : m_pCurrent(new Container(std::move(initial)))
+                {
+                }
+                snapshot_t(snapshot_t const &) = delete;
+                snapshot_t & operator=(snapshot_t const &) = delete;
+
+                /**
+                 * @brief Destroys every version. No reader may be active.
+                 */
+                ~snapshot_t()
+                {
+                    for (retired_t const & retired : m_vecRetired)
+                    {
+                        delete retired.version;
+                    }
+                    delete m_pCurrent.load();
+                }
+
+                /**
+                 * @brief Pins the current snapshot. Lock-free while a reader slot is free: claims it with one compare-and-swap.
+                 * After one full sweep finds every slot taken, the read registers in the overflow list under the writer mutex.
+                 *
+                 * @return reader_t The pinned snapshot.
+                 */
+                reader_t read()
+                {
+                    thread_local size_t t_uHint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+                    for (size_t uSlot = t_uHint; uSlot != t_uHint + zuREADER_SLOTS; ++uSlot)
+                    {
+                        std::atomic<uint64_t> & slotEpoch = m_aSlot[uSlot % zuREADER_SLOTS].epoch;
+                        uint64_t uInactive = inactive_v;
+                        // A stale epoch only delays reclamation; it never lets a version be freed early.
+                        if (slotEpoch.load(std::memory_order_relaxed) == inactive_v
+                            && slotEpoch.compare_exchange_strong(uInactive, m_uEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst))
+                        {
+                            t_uHint = uSlot;
+                            return reader_t(&slotEpoch, m_pCurrent.load(std::memory_order_seq_cst));
+                        }
+                    }
+                    // The writer mutex orders this read with publish(), so the epoch and the version match.
+                    std::lock_guard<std::mutex> const lock(m_mutexWriter);
+                    auto const itOverflow = m_setOverflow.insert(m_uEpoch.load(std::memory_order_seq_cst));
+                    return reader_t(this, itOverflow, m_pCurrent.load(std::memory_order_seq_cst));
+                }
+
+                /**
+                 * @brief Finds the lower bound in the current snapshot.
+                 *
+                 * @return size_t The position of the lower bound within the snapshot that was current at the call.
+                 */
+                template <typename T, typename Compare = std::less<T>, typename Projection = std::identity>
+                size_t lower_bound(T const & value, Compare comp = {}, Projection proj = {})
+                {
+                    reader_t const reader = read();
+                    return static_cast<size_t>(std::distance(std::ranges::begin(*reader), simd::lower_bound(*reader, value, comp, proj)));
+                }
+
+                /**
+                 * @brief Publishes the next version with a single atomic pointer exchange, then reclaims unreachable versions.
+                 *
+                 * @param next The next version.
+                 */
+                void publish(Container next)
+                {
+                    Container const * const pNext = new Container(std::move(next));
+
+                    std::lock_guard<std::mutex> const lock(m_mutexWriter);
+                    Container const * const pPrev = m_pCurrent.exchange(pNext, std::memory_order_seq_cst);
+                    // Readers entering from now on record an epoch of at least uRetire and can only load pNext.
+                    uint64_t const uRetire = m_uEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+                    m_vecRetired.push_back(retired_t{ pPrev, uRetire });
+                    reclaim_locked();
+                }
+
+                /**
+                 * @brief Builds the next version from the current one on a background thread and publishes it.
+                 *
+                 * @param fnBuild Invoked with the current version, returns the next version.
+                 * @return std::future<void> Ready once the next version is published.
+                 */
+                template <typename Tbuild>
+                std::future<void> rebuild_async(Tbuild fnBuild)
+                {
+                    return std::async(std::launch::async, [this, fnBuild = std::move(fnBuild)]() mutable
+                    {
+                        Container next = [&]
+                        {
+                            reader_t const reader = read();
+                            return std::invoke(fnBuild, *reader);
+                        }();
+                        publish(std::move(next));
+                    });
+                }
+
+                /**
+                 * @brief Frees retired versions that readers have released since the last publish.
+                 *
+                 * @return size_t The number of versions freed.
+                 */
+                size_t reclaim()
+                {
+                    std::lock_guard<std::mutex> const lock(m_mutexWriter);
+                    return reclaim_locked();
+                }
+
+                /**
+                 * @brief Returns the number of retired versions still waiting for readers.
+                 */
+                size_t retired()
+                {
+                    std::lock_guard<std::mutex> const lock(m_mutexWriter);
+                    return m_vecRetired.size();
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::lower_bound
+
+#include <atomic>           // for std::atomic
+#include <memory>           // for std::allocator
+#include <vector>           // for std::vector
+#include <span>             // for std::span
+#include <bit>              // for std::has_single_bit, std::countr_zero
+#include <algorithm>        // for std::min
+#include <functional>       // for std::less
+#include <stdexcept>        // for std::invalid_argument, std::length_error
+
+/**
+ * @file lower_bound_time_series.hpp
+ * @brief Provides an append-only sorted array that one writer extends while any number of readers search it without locks.
+ *
+ * Keys live in fixed-size chunks reached through a directory allocated up front, so appending never moves a key a reader
+ * may be looking at. The writer fills keys in, then publishes the new size with a release store; a reader loads the size
+ * with acquire and searches only that prefix, which no later append modifies. A search finds its chunk with
+ * simd::lower_bound over the first keys of the chunks, then its position with simd::lower_bound inside the chunk.
+ * Queries near the newest key, such as "the latest N seconds", can use lower_bound_recent, which gallops backward from the
+ * tail and searches a window sized by the distance from it.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace concurrent
+        {
+            /**
+             * @brief An append-only sorted array with a single writer and lock-free readers.
+             *
+             * @tparam T The type of the keys, e.g. timestamps.
+             * @tparam Compare The order the keys are appended in.
+             * @tparam Allocator The allocator of the chunks and of their first keys.
+             *
+             * @example
+             * jrmwng::algorithm::concurrent::time_series_t<int64_t> series;
+             * series.append(now_ns());                                         // writer thread
+             * size_t first = series.lower_bound_recent(now_ns() - 5'000'000'000); // any reader thread
+             * size_t count = series.size() - first;                            // events of the latest 5 seconds
+             */
+            template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+            class time_series_t
+            {
+                size_t m_uChunkBits;
+                size_t m_uChunkMask;
+                std::vector<std::vector<T, Allocator>> m_vecChunk; // The directory; never resized, so readers may index it while the writer fills it.
+                std::vector<T, Allocator> m_vecFirst;           // The first key of every started chunk.
+                size_t m_uAllocated;                            // Writer only: the number of chunks allocated.
+                size_t m_uWritten;                              // Writer only: the number of keys written, published or not.
+                std::atomic<size_t> m_uPublished;
+                Compare m_comp;
+
+                size_t chunk_size() const
+                {
+                    return m_uChunkMask + 1;
+                }
+
+                /**
+                 * @brief Returns the published keys of a chunk, given a published size.
+                 */
+                std::span<T const> chunk(size_t const uChunk, size_t const uSize) const
+                {
+                    size_t const uFirst = uChunk << m_uChunkBits;
+                    return std::span<T const>(m_vecChunk[uChunk].data(), std::min(chunk_size(), uSize - uFirst));
+                }
+
+                /**
+                 * @brief Finds the lower bound of a value among the first uSize keys.
+                 */
+                size_t lower_bound(T const & value, size_t const uSize) const
+                {
+                    size_t const uChunks = (uSize + m_uChunkMask) >> m_uChunkBits;
+                    std::span<T const> const spanFirst(m_vecFirst.data(), uChunks);
+                    // The first chunk starting at or after the value; the lower bound is in the chunk before it, or at its start.
+                    size_t const uNext = static_cast<size_t>(simd::lower_bound(spanFirst, value, m_comp) - spanFirst.begin());
+                    if (uNext == 0)
+                    {
+                        return 0;
+                    }
+                    std::span<T const> const spanChunk = chunk(uNext - 1, uSize);
+                    return ((uNext - 1) << m_uChunkBits) + static_cast<size_t>(simd::lower_bound(spanChunk, value, m_comp) - spanChunk.begin());
+                }
+
+                /**
+                 * @brief Makes room for key uWritten, allocating its chunk unless reserve already did.
+                 */
+                T * slot()
+                {
+                    size_t const uChunk = m_uWritten >> m_uChunkBits;
+                    if (uChunk == m_uAllocated)
+                    {
+                        m_vecChunk[uChunk] = std::vector<T, Allocator>(chunk_size(), m_vecFirst.get_allocator());
+                        ++m_uAllocated;
+                    }
+                    return m_vecChunk[uChunk].data() + (m_uWritten & m_uChunkMask);
+                }
+
+                /**
+                 * @brief Checks that keys can be appended: in order after the last key, and within the capacity.
+                 */
+                void check(std::span<T const> const values) const
+                {
+                    if (values.size() > capacity() - m_uWritten)
+                    {
+                        throw std::length_error("time_series_t: the chunk directory is full");
+                    }
+                    for (size_t i = 0; i < values.size(); ++i)
+                    {
+                        if ((i > 0 || m_uWritten > 0) && m_comp(values[i], i > 0 ? values[i - 1] : (*this)[m_uWritten - 1]))
+                        {
+                            throw std::invalid_argument("time_series_t: keys must be appended in order");
+                        }
+                    }
+                }
+
+                void push(T const & value)
+                {
+                    *slot() = value;
+                    if ((m_uWritten & m_uChunkMask) == 0)
+                    {
+                        m_vecFirst[m_uWritten >> m_uChunkBits] = value;
+                    }
+                    ++m_uWritten;
+                }
+
+            public:
+                /**
+                 * @brief Creates an empty series.
+                 *
+                 * @param uChunkSize The keys per chunk, a power of two.
+                 * @param uMaxChunks The size of the chunk directory, which bounds the capacity to uChunkSize * uMaxChunks keys.
+                 * @param allocator The allocator of the chunks and of their first keys.
+                 */
+                explicit time_series_t(size_t const uChunkSize = 4096, size_t const uMaxChunks = 65536, Compare comp = {}, Allocator const & allocator = Allocator())
+                    : m_uChunkBits(static_cast<size_t>(std::countr_zero(uChunkSize)))
+                    , m_uChunkMask(uChunkSize - 1)
+                    , m_vecChunk(uMaxChunks, std::vector<T, Allocator>(allocator))
+                    , m_vecFirst(uMaxChunks, allocator)
+                    , m_uAllocated(0)
+                    , m_uWritten(0)
+                    , m_uPublished(0)
+                    , m_comp(comp)
+                {
+                    if (!std::has_single_bit(uChunkSize))
+                    {
+                        throw std::invalid_argument("time_series_t: the chunk size must be a power of two");
+                    }
+                }
+
+                time_series_t(time_series_t const &) = delete;
+                time_series_t & operator=(time_series_t const &) = delete;
+
+                /**
+                 * @brief Returns the number of published keys. Readers may search and index this many keys.
+                 */
+                size_t size() const
+                {
+                    return m_uPublished.load(std::memory_order_acquire);
+                }
+
+                /**
+                 * @brief Returns the number of keys the chunk directory can hold.
+                 */
+                size_t capacity() const
+                {
+                    return m_vecChunk.size() << m_uChunkBits;
+                }
+
+                /**
+                 * @brief Returns a published key, or for the writer, any appended key.
+                 */
+                T const & operator[](size_t const i) const
+                {
+                    return m_vecChunk[i >> m_uChunkBits][i & m_uChunkMask];
+                }
+
+                /**
+                 * @brief Allocates the chunks for uSize keys ahead of time, so that appends up to it do not allocate. Writer only.
+                 */
+                void reserve(size_t const uSize)
+                {
+                    if (uSize > capacity())
+                    {
+                        throw std::length_error("time_series_t: the chunk directory is full");
+                    }
+                    for (size_t const uChunks = (uSize + m_uChunkMask) >> m_uChunkBits; m_uAllocated < uChunks; ++m_uAllocated)
+                    {
+                        m_vecChunk[m_uAllocated] = std::vector<T, Allocator>(chunk_size(), m_vecFirst.get_allocator());
+                    }
+                }
+
+                /**
+                 * @brief Appends a key, not less than the last one, and publishes it. Writer only.
+                 */
+                void append(T const & value)
+                {
+                    check(std::span<T const>(&value, 1));
+                    push(value);
+                    m_uPublished.store(m_uWritten, std::memory_order_release);
+                }
+
+                /**
+                 * @brief Appends sorted keys, not less than the last one, and publishes them together. Writer only.
+                 *
+                 * If the keys cannot be appended, e.g. because a chunk cannot be allocated, none of them is.
+                 */
+                void append(std::span<T const> const values)
+                {
+                    check(values);
+                    // Allocate every chunk of the batch first, so that a failed allocation leaves no key of it written.
+                    reserve(m_uWritten + values.size());
+                    for (T const & value : values)
+                    {
+                        push(value);
+                    }
+                    m_uPublished.store(m_uWritten, std::memory_order_release);
+                }
+
+                /**
+                 * @brief Finds the first published position whose key is not less than the value.
+                 *
+                 * @param value The value to search for.
+                 * @return size_t The position of the lower bound, at most the size published when the search started.
+                 */
+                size_t lower_bound(T const & value) const
+                {
+                    return lower_bound(value, size());
+                }
+
+                /**
+                 * @brief Finds the lower bound by galloping backward from the newest key; O(log d) for a bound d keys from the tail.
+                 *
+                 * @param value The value to search for, typically the start of a recent time window.
+                 * @return size_t The position of the lower bound, as lower_bound.
+                 */
+                size_t lower_bound_recent(T const & value) const
+                {
+                    size_t const uSize = size();
+                    if (uSize == 0)
+                    {
+                        return 0;
+                    }
+                    size_t const uLastChunk = (uSize - 1) >> m_uChunkBits;
+                    std::span<T const> const spanTail = chunk(uLastChunk, uSize);
+                    if (!m_comp(spanTail.front(), value))
+                    {
+                        return lower_bound(value, uSize);   // The bound is in an earlier chunk, or at this one's start.
+                    }
+                    // Double the step back from the tail while the keys are not less than the value; the bound then lies in (uLow, uHigh].
+                    size_t uHigh = spanTail.size();
+                    size_t uStep = 1;
+                    while (uStep < uHigh && !m_comp(spanTail[uHigh - uStep], value))
+                    {
+                        uHigh -= uStep;
+                        uStep *= 2;
+                    }
+                    size_t const uLow = uHigh - std::min(uStep, uHigh);
+                    std::span<T const> const spanWindow = spanTail.subspan(uLow, uHigh - uLow);
+                    return (uLastChunk << m_uChunkBits) + uLow + static_cast<size_t>(simd::lower_bound(spanWindow, value, m_comp) - spanWindow.begin());
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::details::simd_compare_t and simd::details::simd_projection_t
+
+#include <chrono>           // for std::chrono::steady_clock
+#include <filesystem>       // for std::filesystem::path
+#include <fstream>          // for std::ifstream, std::ofstream
+#include <optional>         // for std::optional
+#include <stdexcept>        // for std::invalid_argument
+#include <random>           // for std::minstd_rand, std::uniform_int_distribution
+#include <string>           // for std::string
+#include <string_view>      // for std::string_view
+#include <vector>           // for std::vector
+#include <bit>              // for std::bit_width
+#include <cstdint>          // for uint32_t, int64_t, uint64_t
+
+/**
+ * @file lower_bound_tune.hpp
+ * @brief Provides an autotuner that picks the partition count (fan-out) of the n-ary lower_bound search per dataset.
+ *
+ * The best fan-out depends on the array size, the key type and the cache hierarchy of the host.
+ * The tuner micro-benchmarks every candidate fan-out on the actual data, returns a configured search object,
+ * and can persist the chosen profile to a small text file so later process starts skip the tuning.
+ *
+ * Only the fan-out of the search over a plain sorted array is tuned. The prebuilt layouts (layout::veb_layout_t,
+ * layout::two_level_index_t, layout::radix_spline_t) and simd::kary_lower_bound are not candidates: they need their
+ * own build step and memory, which a per-process tuning run should not pay for every layout. Benchmark them with
+ * their bench programs and pick one at build time.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace tune
+        {
+            namespace details
+            {
+                /**
+                 * @brief The candidate fan-outs, i.e. the number of partition points compared per iteration.
+                 */
+                using fanout_sequence_type = std::index_sequence<1, 2, 4, 8, 16>;
+
+                /**
+                 * @brief Name of a key type, as stored in a profile file.
+                 *
+                 * @tparam T The type of the key.
+                 */
+                template <typename T>
+                constexpr std::string_view key_name_v = {};
+                template <>
+                constexpr std::string_view key_name_v<int> = "int";
+                template <>
+                constexpr std::string_view key_name_v<float> = "float";
+                template <>
+                constexpr std::string_view key_name_v<double> = "double";
+                template <>
+                constexpr std::string_view key_name_v<uint32_t> = "uint32_t";
+                template <>
+                constexpr std::string_view key_name_v<int64_t> = "int64_t";
+                template <>
+                constexpr std::string_view key_name_v<uint64_t> = "uint64_t";
+
+                /**
+                 * @brief Checks whether a fan-out is one of the candidates.
+                 */
+                template <size_t... zuFANOUT_i>
+                constexpr bool is_candidate_fanout(size_t const uFanout, std::index_sequence<zuFANOUT_i...>)
+                {
+                    return ((uFanout == zuFANOUT_i) || ...);
+                }
+
+                /**
+                 * @brief Performs a lower bound search with a compile-time fan-out.
+                 *
+                 * @tparam zuFANOUT The number of partition points compared per iteration.
+                 * @tparam Range The type of the range.
+                 * @tparam T The type of the value to search for.
+                 * @param r The range to search.
+                 * @param value The value to search for.
+                 * @return An iterator to the lower bound of the value in the range.
+                 */
+                template <size_t zuFANOUT, typename Range, typename T>
+                std::ranges::iterator_t<Range> lower_bound(Range && r, T const & value)
+                {
+                    if constexpr (zuFANOUT == 1)
+                    {
+                        return jrmwng::algorithm::ranges::lower_bound(r, value, std::less<T>(), std::identity(), std::make_index_sequence<1>{});
+                    }
+                    else
+                    {
+                        return jrmwng::algorithm::ranges::lower_bound(r, value, simd::details::simd_compare_t<std::less<T>, T>{}, simd::details::simd_projection_t<std::identity>{}, std::make_index_sequence<zuFANOUT>{});
+                    }
+                }
+
+                /**
+                 * @brief Dispatches a runtime fan-out, one of the candidates, to the matching compile-time instantiation.
+                 *
+                 * @return An iterator to the lower bound.
+                 */
+                template <typename Range, typename T, size_t... zuFANOUT_i>
+                std::ranges::iterator_t<Range> dispatch(size_t const uFanout, Range && r, T const & value, std::index_sequence<zuFANOUT_i...>)
+                {
+                    std::ranges::iterator_t<Range> it = std::ranges::begin(r);
+                    ((uFanout == zuFANOUT_i && (it = details::lower_bound<zuFANOUT_i>(r, value), true)) || ...);
+                    return it;
+                }
+            }
+
+            /**
+             * @brief The tuning result for one dataset on one host.
+             */
+            struct search_profile
+            {
+                /**
+                 * @brief Version of the profile file format.
+                 */
+                constexpr static uint32_t version_v = 1;
+
+                std::string key;        ///< Name of the key type, e.g. "int".
+                uint32_t size_class;    ///< `std::bit_width` of the number of keys the profile was tuned for.
+                uint32_t fanout;        ///< The chosen number of partition points per iteration; one of the candidates.
+            };
+
+            /**
+             * @brief Options controlling the micro-benchmark.
+             */
+            struct tune_options
+            {
+                size_t queries = 4096;  ///< Number of lookups timed per candidate.
+                size_t repeats = 3;     ///< Number of timing rounds per candidate; the fastest round wins.
+                uint32_t seed = 1;      ///< Seed for drawing the lookup keys from the data.
+            };
+
+            /**
+             * @brief A lower_bound search object configured by a search_profile.
+             *
+             * @tparam T The type of the key.
+             */
+            template <typename T>
+            class tuned_search_t
+            {
+                search_profile m_profile;
+
+            public:
+                /**
+                 * @brief Configures the search with a profile.
+                 *
+                 * @throws std::invalid_argument if the profile's fan-out is not one of the candidates.
+                 */
+                explicit tuned_search_t(search_profile profile)
+                    : m_profile(std::move(profile))
+                {
+                    if (!details::is_candidate_fanout(m_profile.fanout, details::fanout_sequence_type{}))
+                    {
+                        throw std::invalid_argument("tuned_search_t: the fan-out is not one of the candidates");
+                    }
+                }
+
+                search_profile const & profile() const
+                {
+                    return m_profile;
+                }
+
+                size_t fanout() const
+                {
+                    return m_profile.fanout;
+                }
+
+                /**
+                 * @brief Finds the first position in a sorted range where a given value could be inserted without violating the order.
+                 *
+                 * @param r The range to search.
+                 * @param value The value to compare.
+                 * @return The iterator pointing to the first position where the value could be inserted.
+                 */
+                template <typename Range>
+                requires std::ranges::random_access_range<Range>
+                std::ranges::iterator_t<Range> operator()(Range && r, T const & value) const
+                {
+                    return details::dispatch(m_profile.fanout, r, value, details::fanout_sequence_type{});
+                }
+            };
+
+            /**
+             * @brief Writes a profile to a small text file.
+             *
+             * @param path The path of the profile file.
+             * @param profile The profile to write.
+             * @return true if the profile was written.
+             */
+            inline bool save_profile(std::filesystem::path const & path, search_profile const & profile)
+            {
+                std::ofstream ofs(path, std::ios::trunc);
+                ofs << "lower_bound_profile " << search_profile::version_v << '\n'
+                    << "key " << profile.key << '\n'
+                    << "size_class " << profile.size_class << '\n'
+                    << "fanout " << profile.fanout << '\n';
+                return static_cast<bool>(ofs.flush());
+            }
+
+            /**
+             * @brief Reads a profile written by save_profile.
+             *
+             * @param path The path of the profile file.
+             * @return The profile, or std::nullopt if the file is missing, malformed, of another version or names a fan-out that is
+             * not one of the candidates, so that the caller tunes again.
+             */
+            inline std::optional<search_profile> load_profile(std::filesystem::path const & path)
+            {
+                std::ifstream ifs(path);
+                std::string strTag;
+                uint32_t uVersion = 0;
+                if (!(ifs >> strTag >> uVersion) || strTag != "lower_bound_profile" || uVersion != search_profile::version_v)
+                {
+                    return std::nullopt;
+                }
+
+                search_profile profile{};
+                std::string strKey, strSizeClass, strFanout;
+                if (!(ifs >> strKey >> profile.key >> strSizeClass >> profile.size_class >> strFanout >> profile.fanout)
+                    || strKey != "key" || strSizeClass != "size_class" || strFanout != "fanout"
+                    || !details::is_candidate_fanout(profile.fanout, details::fanout_sequence_type{}))
+                {
+                    return std::nullopt;
+                }
+                return profile;
+            }
+
+            /**
+             * @brief Micro-benchmarks every candidate fan-out on the given sorted range.
+             *
+             * @tparam Range The type of the range.
+             * @param r The sorted range to tune for.
+             * @param options The benchmark options.
+             * @return tuned_search_t The search object configured with the fastest fan-out.
+             *
+             * @example
+             * std::vector<int> vec = ...; // sorted
+             * auto search = jrmwng::algorithm::tune::tune(vec);
+             * auto it = search(vec, 42);
+             */
+            template <typename Range>
+            requires std::ranges::random_access_range<Range>
+            tuned_search_t<std::ranges::range_value_t<Range>> tune(Range && r, tune_options const & options = {})
+            {
+                using T = std::ranges::range_value_t<Range>;
+                static_assert(!details::key_name_v<T>.empty(), "Unsupported key type");
+
+                size_t const uSize = static_cast<size_t>(std::ranges::size(r));
+
+                search_profile profile{ std::string(details::key_name_v<T>), static_cast<uint32_t>(std::bit_width(uSize)), 1 };
+                if (uSize == 0)
+                {
+                    return tuned_search_t<T>(std::move(profile));
+                }
+
+                std::vector<T> vecQuery(options.queries);
+                {
+                    std::minstd_rand rng(options.seed);
+                    std::uniform_int_distribution<size_t> dist(0, uSize - 1);
+                    for (T & tQuery : vecQuery)
+                    {
+                        tQuery = std::ranges::begin(r)[dist(rng)];
+                    }
+                }
+
+                size_t volatile uObserved = 0;
+
+                auto const fnMeasure = [&](auto const zuFANOUT)
+                {
+                    auto durationBest = std::chrono::steady_clock::duration::max();
+                    for (size_t uRepeat = 0; uRepeat < options.repeats; ++uRepeat)
+                    {
+                        size_t uSink = 0;
+                        auto const tpBegin = std::chrono::steady_clock::now();
+                        for (T const & tQuery : vecQuery)
+                        {
+                            uSink += static_cast<size_t>(std::distance(std::ranges::begin(r), details::lower_bound<decltype(zuFANOUT)::value>(r, tQuery)));
+                        }
+                        auto const durationRound = std::chrono::steady_clock::now() - tpBegin;
+                        // Keep the searches observable so they are not optimized away.
+                        uObserved = uSink;
+                        durationBest = std::min(durationBest, durationRound);
+                    }
+                    return durationBest;
+                };
+
+                auto durationBest = std::chrono::steady_clock::duration::max();
+                [&]<size_t... zuFANOUT_i>(std::index_sequence<zuFANOUT_i...>)
+                {
+                    ([&]
+                    {
+                        auto const duration = fnMeasure(std::integral_constant<size_t, zuFANOUT_i>{});
+                        if (duration < durationBest)
+                        {
+                            durationBest = duration;
+                            profile.fanout = zuFANOUT_i;
+                        }
+                    }(), ...);
+                }(details::fanout_sequence_type{});
+
+                return tuned_search_t<T>(std::move(profile));
+            }
+
+            /**
+             * @brief Loads the profile from a file if it matches the dataset, otherwise tunes and saves the new profile.
+             *
+             * @tparam Range The type of the range.
+             * @param r The sorted range to tune for.
+             * @param path The path of the profile file.
+             * @param options The benchmark options.
+             * @return tuned_search_t The configured search object.
+             */
+            template <typename Range>
+            requires std::ranges::random_access_range<Range>
+            tuned_search_t<std::ranges::range_value_t<Range>> tune(Range && r, std::filesystem::path const & path, tune_options const & options = {})
+            {
+                using T = std::ranges::range_value_t<Range>;
+
+                if (std::optional<search_profile> optProfile = load_profile(path))
+                {
+                    if (optProfile->key == details::key_name_v<T> && optProfile->size_class == static_cast<uint32_t>(std::bit_width(static_cast<size_t>(std::ranges::size(r)))))
+                    {
+                        return tuned_search_t<T>(std::move(*optProfile));
+                    }
+                }
+
+                tuned_search_t<T> search = tune(r, options);
+                save_profile(path, search.profile());
+                return search;
+            }
+        }
+    }
+}
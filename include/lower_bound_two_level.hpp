@@ -0,0 +1,236 @@
+#pragma once
+
+#include "lower_bound_simd.hpp"         // Project-specific header for simd::lower_bound
+#include "lower_bound_normalize.hpp"    // Project-specific header for keys::normalize
+
+#include <span>             // for std::span
+#include <vector>           // for std::vector
+#include <utility>          // for std::pair
+#include <bit>              // for std::bit_width, std::popcount
+#include <cstdint>          // for int16_t, uint16_t
+#include <algorithm>        // for std::min
+
+#if defined(__AVX2__) || defined(__AVX512BW__)
+#include <immintrin.h>      // for _mm256_cmpgt_epi16, _mm512_cmpgt_epi16_mask
+#endif
+
+/**
+ * @file lower_bound_two_level.hpp
+ * @brief Provides a two-level index whose top level holds 16-bit quantized summaries small enough to stay in L1.
+ *
+ * Every Nth key is quantized to the top 16 bits of its order-preserving normalized form, relative to the smallest key.
+ * The summaries are stored as a static search tree of 16-lane (32-lane with AVX-512BW) nodes, so each tree level costs one
+ * `epi16` compare. The result narrows the search to a block of about N keys of the full-width array, which simd::lower_bound finishes.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace layout
+        {
+            namespace details
+            {
+                /**
+                 * @brief Compares 16-bit summaries a node at a time.
+                 */
+                struct summary_traits
+                {
+#if defined(__AVX512BW__)
+                    constexpr static size_t lanes_v = 32;
+#else
+                    constexpr static size_t lanes_v = 16;
+#endif
+                    /**
+                     * @brief Counts the entries of a node that are less than a value.
+                     *
+                     * @param pNode The node of lanes_v biased summaries.
+                     * @param nValue The biased value.
+                     */
+                    static size_t count_less(int16_t const * const pNode, int16_t const nValue)
+                    {
+#if defined(__AVX512BW__)
+                        __m512i const zmmNode = _mm512_loadu_si512(pNode);
+                        return static_cast<size_t>(std::popcount(static_cast<uint32_t>(_mm512_cmpgt_epi16_mask(_mm512_set1_epi16(nValue), zmmNode))));
+#elif defined(__AVX2__)
+                        __m256i const ymmNode = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(pNode));
+                        // movemask_epi8 yields two bits per 16-bit lane.
+                        return static_cast<size_t>(std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi16(_mm256_set1_epi16(nValue), ymmNode))))) / 2;
+#else
+                        size_t uCount = 0;
+                        for (size_t i = 0; i < lanes_v; ++i)
+                        {
+                            uCount += pNode[i] < nValue;
+                        }
+                        return uCount;
+#endif
+                    }
+                };
+            }
+
+            /**
+             * @brief Two-level index over a sorted array: an L1-resident tree of 16-bit quantized summaries above the full-width keys.
+             *
+             * @tparam T The type of the keys; any type supported by keys::normalize. Floating-point keys must be NaN-free.
+             * @tparam Allocator The allocator of the summaries.
+             *
+             * @example
+             * std::vector<int64_t> vec = ...; // sorted, must outlive the index
+             * jrmwng::algorithm::layout::two_level_index_t<int64_t> index(vec);
+             * size_t pos = index.lower_bound(42);
+             */
+            template <typename T, typename Allocator = std::allocator<int16_t>>
+            class two_level_index_t
+            {
+                using normalized_type = keys::normalized_t<T>;
+                using level_type = std::vector<int16_t, Allocator>;
+                using traits_type = details::summary_traits;
+
+                constexpr static int16_t pad_v = INT16_MAX; // Biased form of the largest summary 0xFFFF.
+
+                std::span<T const> m_spanKey;
+                size_t m_uBlock;
+                size_t m_uSummaries;
+                normalized_type m_uMin;
+                unsigned m_uShift;
+                std::vector<level_type> m_vecLevel; // [0] holds every summary, back() is the single root node.
+
+                /**
+                 * @brief Counts the summaries less than a biased value by descending the tree.
+                 */
+                size_t count_less(int16_t const nValue) const
+                {
+                    size_t uIndex = 0;
+                    for (size_t uLevel = m_vecLevel.size(); uLevel-- > 1;)
+                    {
+                        // A value above every child maximum descends into the last child node; the level below has no node past it.
+                        size_t const uChild = uIndex * traits_type::lanes_v + traits_type::count_less(m_vecLevel[uLevel].data() + uIndex * traits_type::lanes_v, nValue);
+                        uIndex = std::min(uChild, m_vecLevel[uLevel - 1].size() / traits_type::lanes_v - 1);
+                    }
+                    uIndex = uIndex * traits_type::lanes_v + traits_type::count_less(m_vecLevel[0].data() + uIndex * traits_type::lanes_v, nValue);
+                    return std::min(uIndex, m_uSummaries);
+                }
+
+            public:
+                /**
+                 * @brief Builds the summaries of a sorted array.
+                 *
+                 * @param data The sorted keys. The index refers to them and must not outlive them.
+                 * @param uBlock Keys per summary; 0 picks the smallest power of two, at least 64, that keeps the summaries within 16KB.
+                 * @param allocator The allocator of the summaries.
+                 */
+                explicit two_level_index_t(std::span<T const> data, size_t uBlock = 0, Allocator const & allocator = Allocator())
+                    : m_spanKey(data)
+                    , m_uBlock(uBlock)
+                    , m_uSummaries(0)
+                    , m_uMin(0)
+                    , m_uShift(0)
+                {
+                    if (m_uBlock == 0)
+                    {
+                        constexpr size_t max_summaries_v = 8192;
+                        m_uBlock = 64;
+                        while (data.size() / m_uBlock > max_summaries_v)
+                        {
+                            m_uBlock *= 2;
+                        }
+                    }
+                    if (data.empty())
+                    {
+                        return;
+                    }
+
+                    m_uMin = keys::normalize(data.front());
+                    normalized_type const uRange = keys::normalize(data.back()) - m_uMin;
+                    m_uShift = std::bit_width(uRange) > 16 ? static_cast<unsigned>(std::bit_width(uRange) - 16) : 0;
+
+                    m_uSummaries = (data.size() + m_uBlock - 1) / m_uBlock;
+                    level_type vecSummary(allocator);
+                    vecSummary.reserve(m_uSummaries);
+                    for (size_t i = 0; i < data.size(); i += m_uBlock)
+                    {
+                        vecSummary.push_back(quantize(data[i]));
+                    }
+
+                    // Pad every level to whole nodes; a parent node holds the last entry of each child node.
+                    for (;;)
+                    {
+                        vecSummary.resize((vecSummary.size() + traits_type::lanes_v - 1) / traits_type::lanes_v * traits_type::lanes_v, pad_v);
+                        size_t const uNodes = vecSummary.size() / traits_type::lanes_v;
+                        m_vecLevel.push_back(std::move(vecSummary));
+                        if (uNodes == 1)
+                        {
+                            break;
+                        }
+                        vecSummary.clear();
+                        for (size_t uNode = 0; uNode < uNodes; ++uNode)
+                        {
+                            vecSummary.push_back(m_vecLevel.back()[uNode * traits_type::lanes_v + traits_type::lanes_v - 1]);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Quantizes a key to its biased 16-bit summary. Monotone: a < b implies quantize(a) <= quantize(b).
+                 */
+                int16_t quantize(T const tValue) const
+                {
+                    normalized_type const uValue = keys::normalize(tValue);
+                    normalized_type const uOffset = (uValue > m_uMin) ? static_cast<normalized_type>((uValue - m_uMin) >> m_uShift) : 0;
+                    return static_cast<int16_t>(static_cast<uint16_t>(std::min<normalized_type>(uOffset, 0xFFFF)) ^ 0x8000);
+                }
+
+                size_t block_size() const
+                {
+                    return m_uBlock;
+                }
+
+                /**
+                 * @brief Returns the bytes held by the summary tree.
+                 */
+                size_t summary_bytes() const
+                {
+                    size_t uBytes = 0;
+                    for (level_type const & vecLevel : m_vecLevel)
+                    {
+                        uBytes += vecLevel.size() * sizeof(int16_t);
+                    }
+                    return uBytes;
+                }
+
+                /**
+                 * @brief Narrows the lower bound of a value to a range of positions using only the summaries.
+                 *
+                 * @return std::pair<size_t, size_t> The [first, last) positions the lower bound lies within.
+                 */
+                std::pair<size_t, size_t> block_range(T const tValue) const
+                {
+                    if (m_uSummaries == 0)
+                    {
+                        return { 0, 0 };
+                    }
+                    int16_t const nValue = quantize(tValue);
+                    // Sampled keys with a smaller summary are less than the value, those with a larger one are greater.
+                    size_t const uLess = count_less(nValue);
+                    size_t const uLessEqual = (nValue == pad_v) ? m_uSummaries : count_less(static_cast<int16_t>(nValue + 1));
+                    size_t const uFirst = uLess ? (uLess - 1) * m_uBlock + 1 : 0;
+                    size_t const uLast = (uLessEqual < m_uSummaries) ? uLessEqual * m_uBlock : m_spanKey.size();
+                    return { uFirst, uLast };
+                }
+
+                /**
+                 * @brief Finds the first position in the array where the value could be inserted without violating the order.
+                 *
+                 * @param tValue The value to compare.
+                 * @return size_t The position of the lower bound.
+                 */
+                size_t lower_bound(T const tValue) const
+                {
+                    auto const [uFirst, uLast] = block_range(tValue);
+                    std::span<T const> const spanBlock = m_spanKey.subspan(uFirst, uLast - uFirst);
+                    return uFirst + static_cast<size_t>(simd::lower_bound(spanBlock, tValue) - spanBlock.begin());
+                }
+            };
+        }
+    }
+}
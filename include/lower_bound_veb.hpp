@@ -0,0 +1,401 @@
+#pragma once
+
+#include "lower_bound_simd.hpp" // Project-specific header for simd::details::simd_compare_t and simd::details::simd_projection_t
+#include "lower_bound_parallel.hpp" // Project-specific header for parallel::parallel_for
+
+#include <array>            // for std::array
+#include <span>             // for std::span
+#include <vector>           // for std::vector
+#include <memory>           // for std::allocator
+#include <bit>              // for std::popcount
+#include <utility>          // for std::index_sequence, std::make_index_sequence
+#include <algorithm>        // for std::min, std::max
+#include <thread>           // for std::thread::hardware_concurrency
+#include <atomic>           // for std::atomic
+#include <functional>       // for std::less, std::identity
+#include <stdexcept>        // for std::invalid_argument
+
+/**
+ * @file lower_bound_veb.hpp
+ * @brief Provides a cache-oblivious static search tree stored in van Emde Boas order.
+ *
+ * The keys form a complete (K+1)-ary search tree whose nodes hold K keys, one SIMD register's worth. The nodes are stored
+ * in van Emde Boas order: a tree of height h is split into a top tree of height h/2 and the bottom trees hanging from it,
+ * the top tree is stored first and every bottom tree after it contiguously, each recursively in the same order. Any
+ * subtree of height h' then spans O((K+1)^h') consecutive nodes, so a descent touches O(log_B N) blocks for every block
+ * size B at once: cache lines, pages and disk blocks alike.
+ *
+ * The descent computes node positions from per-depth tables (Brodal, Fagerberg and Jacob): the position of the node at
+ * depth d follows from the position of its ancestor at the depth whose top tree the split at d hangs below. Ranks of the
+ * keys in the sorted input follow from the node's index within its level, so results map back to input positions without
+ * storing them. The tree is complete, but the trailing bottom trees of the root split that hold only padding are not stored,
+ * so the padding is less than one such bottom tree, about sqrt((K+1)^h) keys.
+ */
+
+namespace jrmwng
+{
+    namespace algorithm
+    {
+        namespace layout
+        {
+            namespace details
+            {
+                /**
+                 * @brief The shape of a complete tree in van Emde Boas order and the per-depth tables that locate its nodes.
+                 */
+                struct veb_shape_t
+                {
+                    constexpr static size_t max_height_v = 64;
+
+                    size_t fanout = 0;
+                    size_t height = 0;
+                    size_t nodes = 0;
+                    std::array<size_t, max_height_v> top_depth{};   // Depth of the root of the top tree the split at d hangs below.
+                    std::array<size_t, max_height_v> top_nodes{};   // Nodes in that top tree.
+                    std::array<size_t, max_height_v> bottom_nodes{};// Nodes in each bottom tree rooted at depth d.
+                    std::array<size_t, max_height_v> bottom_count{};// Bottom trees per top tree: fanout^(d - top_depth[d]).
+                    std::array<size_t, max_height_v> key_stride{};  // Keys in a subtree rooted at depth d + 1, plus one.
+
+                    static size_t power(size_t const uBase, size_t const uExponent)
+                    {
+                        size_t uPower = 1;
+                        for (size_t i = 0; i < uExponent; ++i)
+                        {
+                            uPower *= uBase;
+                        }
+                        return uPower;
+                    }
+
+                    size_t tree_nodes(size_t const uHeight) const
+                    {
+                        return (power(fanout, uHeight) - 1) / (fanout - 1);
+                    }
+
+                    void split(size_t const uDepth, size_t const uHeight)
+                    {
+                        if (uHeight <= 1)
+                        {
+                            return;
+                        }
+                        size_t const uTop = uHeight / 2;
+                        size_t const uBottom = uHeight - uTop;
+                        top_depth[uDepth + uTop] = uDepth;
+                        top_nodes[uDepth + uTop] = tree_nodes(uTop);
+                        bottom_nodes[uDepth + uTop] = tree_nodes(uBottom);
+                        bottom_count[uDepth + uTop] = power(fanout, uTop);
+                        split(uDepth, uTop);
+                        split(uDepth + uTop, uBottom);
+                    }
+
+                    veb_shape_t() = default;
+
+                    /**
+                     * @brief Shapes the smallest complete tree of nodes with uKeysPerNode keys that holds uSize keys.
+                     */
+                    veb_shape_t(size_t const uSize, size_t const uKeysPerNode)
+                        : fanout(uKeysPerNode + 1)
+                    {
+                        while (power(fanout, height) - 1 < uSize)
+                        {
+                            ++height;
+                        }
+                        // Bottom trees of the root split whose keys all rank past uSize are never visited, and they come last: drop them.
+                        if (height <= 1)
+                        {
+                            nodes = height;
+                        }
+                        else
+                        {
+                            size_t const uTop = height / 2;
+                            size_t const uBottomKeys = power(fanout, height - uTop);
+                            nodes = tree_nodes(uTop) + (uSize + uBottomKeys - 1) / uBottomKeys * tree_nodes(height - uTop);
+                        }
+                        for (size_t d = 0; d < height; ++d)
+                        {
+                            key_stride[d] = power(fanout, height - d - 1);
+                        }
+                        split(0, height);
+                    }
+
+                    /**
+                     * @brief Returns the position of the node at depth d, given the positions and level indices of its ancestors.
+                     */
+                    size_t position(size_t const d, size_t const uIndex, size_t const * const pPos, size_t const * const pIndex) const
+                    {
+                        if (d == 0)
+                        {
+                            return 0;
+                        }
+                        size_t const uTop = top_depth[d];
+                        return pPos[uTop] + top_nodes[d] + (uIndex - pIndex[uTop] * bottom_count[d]) * bottom_nodes[d];
+                    }
+                };
+            }
+
+            /**
+             * @brief A non-owning view of nodes in van Emde Boas order, e.g. mapped from a file.
+             *
+             * @tparam T The type of the keys; must have simd_traits.
+             */
+            template <typename T>
+            class veb_view_t
+            {
+                using traits_type = simd::details::simd_traits<T>;
+
+            public:
+                constexpr static size_t node_keys_v = traits_type::simd_size_v;
+
+            private:
+                std::span<T const> m_spanNode;
+                size_t m_uSize;
+                details::veb_shape_t m_shape;
+
+                template <typename Compare, typename Projection, size_t... zuLANE_i>
+                static int compare_node(T const * const pNode, T const & value, Compare const & comp, Projection const & proj, std::index_sequence<zuLANE_i...>)
+                {
+                    return simd::details::simd_compare_t<Compare, T>{ comp }(simd::details::simd_projection_t<Projection>{ proj }(pNode[zuLANE_i]...), value);
+                }
+
+            public:
+                veb_view_t()
+                    : m_uSize(0)
+                {
+                }
+
+                /**
+                 * @brief Views the nodes of a layout built from uSize keys.
+                 *
+                 * @param nodes The nodes, node_keys_v keys each, in van Emde Boas order.
+                 * @param uSize The number of keys the layout was built from.
+                 */
+                veb_view_t(std::span<T const> nodes, size_t const uSize)
+                    : m_spanNode(nodes)
+                    , m_uSize(uSize)
+                    , m_shape(uSize, node_keys_v)
+                {
+                    if (m_spanNode.size() < m_shape.nodes * node_keys_v)
+                    {
+                        throw std::invalid_argument("veb_view_t: too few nodes for the size");
+                    }
+                }
+
+                size_t size() const
+                {
+                    return m_uSize;
+                }
+
+                /**
+                 * @brief Returns the stored nodes, node_keys_v keys each.
+                 */
+                std::span<T const> nodes() const
+                {
+                    return m_spanNode;
+                }
+
+                /**
+                 * @brief Finds the position in the sorted input of the first key not less than the value.
+                 *
+                 * @param value The value to search for.
+                 * @param comp The comparison function, as for simd::lower_bound.
+                 * @param proj The projection function, as for simd::lower_bound.
+                 * @return size_t The position of the lower bound in the sorted input.
+                 */
+                template <typename Compare = std::less<T>, typename Projection = std::identity>
+                size_t lower_bound(T const & value, Compare comp = {}, Projection proj = {}) const
+                {
+                    std::array<size_t, details::veb_shape_t::max_height_v> aPos;
+                    std::array<size_t, details::veb_shape_t::max_height_v> aIndex;
+
+                    size_t uResult = m_uSize;
+                    size_t uIndex = 0;  // Index of the node within its level.
+                    size_t uBase = 0;   // Rank of the first key of the node's subtree.
+                    for (size_t d = 0; d < m_shape.height && uBase < m_uSize; ++d)
+                    {
+                        aPos[d] = m_shape.position(d, uIndex, aPos.data(), aIndex.data());
+                        aIndex[d] = uIndex;
+
+                        // Key j of the node has rank uBase + (j + 1) * stride - 1; the lanes at or past m_uSize are padding.
+                        size_t const uStride = m_shape.key_stride[d];
+                        size_t const uValid = std::min(node_keys_v, (m_uSize - uBase) / uStride);
+                        unsigned const uMask = static_cast<unsigned>(compare_node(m_spanNode.data() + aPos[d] * node_keys_v, value, comp, proj, std::make_index_sequence<node_keys_v>{}));
+                        size_t const uLess = static_cast<size_t>(std::popcount(uMask & ((1u << uValid) - 1)));
+                        if (uLess < uValid)
+                        {
+                            uResult = uBase + (uLess + 1) * uStride - 1;
+                        }
+                        uBase += uLess * uStride;
+                        uIndex = uIndex * m_shape.fanout + uLess;
+                    }
+                    return uResult;
+                }
+            };
+
+            /**
+             * @brief A sorted array rearranged into van Emde Boas order for cache-oblivious search.
+             *
+             * @tparam T The type of the keys; must have simd_traits.
+             * @tparam Allocator The allocator of the nodes.
+             *
+             * @example
+             * std::vector<int> vec = {1, 2, 4, 5, 6};
+             * jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+             * size_t pos = veb.lower_bound(3); // 2, the position in vec
+             */
+            template <typename T, typename Allocator = std::allocator<T>>
+            class veb_layout_t
+            {
+                /**
+                 * @brief The positions and level indices of the ancestors of the node being built.
+                 */
+                struct cursor_t
+                {
+                    std::array<size_t, details::veb_shape_t::max_height_v> pos;
+                    std::array<size_t, details::veb_shape_t::max_height_v> index;
+                };
+
+                /**
+                 * @brief A subtree left for a worker thread, with the cursor of its ancestors.
+                 */
+                struct task_t
+                {
+                    size_t index;
+                    size_t base;
+                    cursor_t cursor;
+                };
+
+                std::vector<T, Allocator> m_vecNode;
+                veb_view_t<T> m_view;
+
+                /**
+                 * @brief Visits the subtree of a node at depth d in preorder, writing every node's keys at its van Emde Boas position.
+                 *
+                 * Subtrees rooted at depth uSplit are appended to pvecTask instead of being visited.
+                 */
+                void build(details::veb_shape_t const & shape, std::span<T const> const data, size_t const d, size_t const uIndex, size_t const uBase,
+                    cursor_t & cursor, size_t const uSplit, std::vector<task_t> * const pvecTask)
+                {
+                    if (d == uSplit)
+                    {
+                        pvecTask->push_back(task_t{ uIndex, uBase, cursor });
+                        return;
+                    }
+                    cursor.pos[d] = shape.position(d, uIndex, cursor.pos.data(), cursor.index.data());
+                    cursor.index[d] = uIndex;
+                    size_t const uStride = shape.key_stride[d];
+                    for (size_t j = 0; j < node_keys_v; ++j)
+                    {
+                        m_vecNode[cursor.pos[d] * node_keys_v + j] = data[std::min(uBase + (j + 1) * uStride - 1, data.size() - 1)];
+                    }
+                    if (d + 1 < shape.height)
+                    {
+                        for (size_t c = 0; c < shape.fanout && uBase + c * uStride < data.size(); ++c)
+                        {
+                            build(shape, data, d + 1, uIndex * shape.fanout + c, uBase + c * uStride, cursor, uSplit, pvecTask);
+                        }
+                    }
+                }
+
+            public:
+                constexpr static size_t node_keys_v = veb_view_t<T>::node_keys_v;
+
+                /**
+                 * @brief Builds the layout from sorted keys.
+                 *
+                 * @param data The sorted keys.
+                 */
+                explicit veb_layout_t(std::span<T const> data, Allocator const & allocator = Allocator())
+                    : veb_layout_t(data, 1, allocator)
+                {
+                }
+
+                /**
+                 * @brief Builds the layout from sorted keys on several threads, each writing whole subtrees.
+                 *
+                 * @param data The sorted keys.
+                 * @param uThreads The number of threads; 0 for std::thread::hardware_concurrency().
+                 */
+                veb_layout_t(std::span<T const> data, size_t uThreads, Allocator const & allocator = Allocator())
+                    : m_vecNode(allocator)
+                {
+                    details::veb_shape_t const shape(data.size(), node_keys_v);
+                    m_vecNode.resize(shape.nodes * node_keys_v);
+                    if (uThreads == 0)
+                    {
+                        uThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+                    }
+
+                    // Split at the shallowest depth with enough subtrees to balance the threads; the levels above are few nodes.
+                    size_t uSplit = shape.height;
+                    if (uThreads > 1)
+                    {
+                        for (size_t d = 1, uSubtrees = shape.fanout; d < shape.height; ++d, uSubtrees *= shape.fanout)
+                        {
+                            if (uSubtrees >= 8 * uThreads)
+                            {
+                                uSplit = d;
+                                break;
+                            }
+                        }
+                    }
+
+                    std::vector<task_t> vecTask;
+                    cursor_t cursor;
+                    if (shape.height)
+                    {
+                        build(shape, data, 0, 0, 0, cursor, uSplit, &vecTask);
+                    }
+                    if (!vecTask.empty())
+                    {
+                        std::atomic<size_t> uNext = 0;
+                        auto const fnWork = [&]
+                        {
+                            for (size_t i; (i = uNext.fetch_add(1, std::memory_order_relaxed)) < vecTask.size();)
+                            {
+                                build(shape, data, uSplit, vecTask[i].index, vecTask[i].base, vecTask[i].cursor, shape.height, nullptr);
+                            }
+                        };
+                        parallel::parallel_for(std::min(uThreads, vecTask.size()), [&](size_t)
+                        {
+                            fnWork();
+                        });
+                    }
+                    m_view = veb_view_t<T>(m_vecNode, data.size());
+                }
+
+                veb_layout_t(veb_layout_t && that) = default;
+                veb_layout_t(veb_layout_t const &) = delete;
+                veb_layout_t & operator=(veb_layout_t const &) = delete;
+
+                size_t size() const
+                {
+                    return m_view.size();
+                }
+
+                /**
+                 * @brief Returns the bytes held by the nodes, including the padding of the last bottom tree.
+                 */
+                size_t bytes() const
+                {
+                    return m_vecNode.size() * sizeof(T);
+                }
+
+                /**
+                 * @brief Returns a non-owning view of the layout.
+                 */
+                veb_view_t<T> const & view() const
+                {
+                    return m_view;
+                }
+
+                /**
+                 * @brief Finds the position in the sorted input of the first key not less than the value.
+                 */
+                template <typename Compare = std::less<T>, typename Projection = std::identity>
+                size_t lower_bound(T const & value, Compare comp = {}, Projection proj = {}) const
+                {
+                    return m_view.lower_bound(value, comp, proj);
+                }
+            };
+        }
+    }
+}
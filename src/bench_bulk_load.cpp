@@ -0,0 +1,58 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstdint>
+#include "lower_bound_bulk_load.hpp"
+#include "lower_bound_veb.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_bulk_load [keys=33554432] [max_threads=hardware_concurrency]
+int main(int argc, char **argv) {
+    size_t const count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 25);
+    size_t const max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<uint64_t> input(count);
+    std::mt19937_64 rng(1);
+    for (uint64_t &key : input) {
+        key = rng() % (count * 4);
+    }
+
+    size_t checksum = 0;
+    std::vector<uint64_t> keys;
+    double const sort = measure(count, [&] {
+        keys = input;
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    });
+    double const build = measure(count, [&] {
+        jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb(keys);
+        checksum += veb.lower_bound(input[0]);
+    });
+    std::cout << count << " uint64_t keys, " << keys.size() << " distinct" << std::endl;
+    std::cout << "std::sort + std::unique: " << sort << " ns/key; veb build: " << build << " ns/key" << std::endl;
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<uint64_t> bulk;
+        double const load = measure(count, [&] {
+            bulk = jrmwng::algorithm::bulk::load(std::span<uint64_t const>(input), {.threads = threads, .dedupe = true});
+        });
+        double const threaded = measure(count, [&] {
+            jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb(bulk, threads);
+            checksum += veb.lower_bound(input[0]);
+        });
+        std::cout << threads << " threads: bulk::load " << load << " ns/key (" << sort / load << "x); veb build "
+                  << threaded << " ns/key (" << build / threaded << "x)" << (bulk == keys ? "" : " MISMATCH") << std::endl;
+    }
+    return checksum == 0 ? 0 : 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_cascade.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_cascade [keys_per_run=4194304] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 22);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::cout << keys << " uint32_t keys per run, " << lookups << " random lookups returning the lower bound in every run" << std::endl;
+    for (size_t run_count : {5, 10}) {
+        std::mt19937 rng(1);
+        std::vector<std::vector<uint32_t>> runs(run_count, std::vector<uint32_t>(keys));
+        for (auto &run : runs) {
+            for (uint32_t &key : run) {
+                key = static_cast<uint32_t>(rng());
+            }
+            std::sort(run.begin(), run.end());
+        }
+        std::vector<uint32_t> queries(lookups);
+        for (uint32_t &query : queries) {
+            query = static_cast<uint32_t>(rng());
+        }
+
+        std::vector<size_t> positions(run_count);
+        size_t checksum[2] = {};
+        double const independent = measure(lookups, [&] {
+            for (uint32_t query : queries) {
+                for (size_t i = 0; i < run_count; ++i) {
+                    positions[i] = static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(runs[i], query) - runs[i].begin());
+                }
+                checksum[0] += positions[run_count - 1];
+            }
+        });
+        std::cout << run_count << " runs: independent simd::lower_bound " << independent << " ns";
+        for (size_t sample : {2, 4, 8}) {
+            jrmwng::algorithm::layout::cascade_t<uint32_t> cascade(runs, sample);
+            checksum[1] = 0;
+            double const cascaded = measure(lookups, [&] {
+                for (uint32_t query : queries) {
+                    cascade.lower_bound(query, positions);
+                    checksum[1] += positions[run_count - 1];
+                }
+            });
+            std::cout << "; cascade p=" << sample << " " << cascaded << " ns (" << independent / cascaded << "x, "
+                      << static_cast<double>(cascade.augmented_size()) / static_cast<double>(keys * run_count) << "x keys)"
+                      << (checksum[0] == checksum[1] ? "" : " MISMATCH");
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
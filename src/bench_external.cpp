@@ -0,0 +1,69 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include "lower_bound_external.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_external [keys=16777216] [lookups=200000] [direct=0]
+// direct=1 opens the file with O_DIRECT, so every leaf read goes to the device instead of the page cache.
+int main(int argc, char **argv) {
+    size_t const count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+    bool const direct = argc > 3 && std::strcmp(argv[3], "0") != 0;
+
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_bench_external.bpt";
+    {
+        std::vector<uint64_t> keys(count);
+        for (size_t i = 0; i < count; ++i) {
+            keys[i] = 2 * i;
+        }
+        jrmwng::algorithm::external::bulk_load(path, keys);
+    }
+
+    std::vector<uint64_t> queries(lookups);
+    std::mt19937_64 rng(1);
+    for (uint64_t &query : queries) {
+        query = rng() % (2 * count);
+    }
+
+    std::cout << count << " uint64_t keys (" << std::filesystem::file_size(path) / (1024 * 1024) << " MB file), " << lookups
+              << " random lookups, cache of 256 pages" << (direct ? ", O_DIRECT" : ", page cache") << std::endl;
+    for (auto backend : {jrmwng::algorithm::external::io_backend::pread, jrmwng::algorithm::external::io_backend::io_uring}) {
+        for (size_t batch : {1, 16, 256}) {
+            jrmwng::algorithm::external::reader_options options;
+            options.backend = backend;
+            options.cache_pages = 256;
+            options.direct_io = direct;
+            try {
+                jrmwng::algorithm::external::btree_reader_t<uint64_t> reader(path, options);
+                std::vector<size_t> results(batch);
+                size_t checksum = 0;
+                double const ns = measure(lookups, [&] {
+                    for (size_t i = 0; i + batch <= lookups; i += batch) {
+                        reader.lower_bound(std::span<uint64_t const>(queries.data() + i, batch), results);
+                        checksum += results[0];
+                    }
+                });
+                std::cout << (reader.uses_io_uring() ? "io_uring" : "pread   ") << " batch " << batch << ": " << ns << " ns, "
+                          << static_cast<double>(reader.page_reads()) / static_cast<double>(lookups) << " reads/lookup" << (checksum ? "" : " ") << std::endl;
+            } catch (std::exception const &e) {
+                std::cout << "batch " << batch << ": " << e.what() << std::endl;
+            }
+        }
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
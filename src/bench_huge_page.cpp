@@ -0,0 +1,105 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_huge_page.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counts data-TLB load misses of the calling thread, when the kernel allows it.
+class DtlbMissCounter {
+public:
+    DtlbMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~DtlbMissCounter() {
+#if defined(__linux__)
+        if (m_fd >= 0) ::close(m_fd);
+#endif
+    }
+    bool valid() const { return m_fd >= 0; }
+    void start() {
+#if defined(__linux__)
+        if (m_fd >= 0) {
+            ::ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    uint64_t stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (m_fd >= 0) {
+            ::ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (::read(m_fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+        }
+#endif
+        return count;
+    }
+private:
+    int m_fd = -1;
+};
+
+template <typename Vector>
+void run(char const *name, size_t size, std::vector<int> const &queries) {
+    Vector vec(size);
+    for (size_t i = 0; i < size; ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+
+    DtlbMissCounter counter;
+    size_t sink = 0;
+    counter.start();
+    auto const begin = std::chrono::steady_clock::now();
+    for (int query : queries) {
+        sink += static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(vec, query) - vec.begin());
+    }
+    auto const end = std::chrono::steady_clock::now();
+    uint64_t const misses = counter.stop();
+
+    double const ns = std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(queries.size());
+    std::cout << name << ": " << ns << " ns/lookup";
+    if (counter.valid()) {
+        std::cout << ", " << static_cast<double>(misses) / static_cast<double>(queries.size()) << " dTLB misses/lookup";
+    } else {
+        std::cout << ", dTLB misses unavailable";
+    }
+    std::cout << " (checksum " << sink << ")" << std::endl;
+}
+
+// Usage: lower_bound_bench_huge_page [elements=1073741824] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 30);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::vector<int> queries(lookups);
+    std::minstd_rand rng(1);
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(size - 1));
+    for (int &query : queries) {
+        query = dist(rng);
+    }
+
+    std::cout << size << " int elements, " << lookups << " random lookups" << std::endl;
+    run<std::vector<int>>("std::allocator        ", size, queries);
+    run<jrmwng::algorithm::memory::huge_page_vector<int>>("huge_page_allocator   ", size, queries);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_interleave.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_interleave [elements=268435456] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 28);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::vector<int> vec(size);
+    for (size_t i = 0; i < size; ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+    std::vector<int> keys(lookups);
+    std::minstd_rand rng(1);
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(size - 1));
+    for (int &key : keys) {
+        key = dist(rng);
+    }
+    std::vector<size_t> results(lookups);
+
+    std::cout << size << " int elements, " << lookups << " random lookups" << std::endl;
+    double const sequential = measure(lookups, [&] {
+        for (size_t i = 0; i < lookups; ++i) {
+            results[i] = static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(vec, keys[i]) - vec.begin());
+        }
+    });
+    std::cout << "simd::lower_bound   : " << sequential << " ns/lookup" << std::endl;
+
+    for (size_t in_flight : {1, 4, 8, 12, 16, 24, 32}) {
+        double const interleaved = measure(lookups, [&] {
+            jrmwng::algorithm::interleave::run(in_flight, lookups, [&](size_t i) { return jrmwng::algorithm::interleave::lower_bound(vec, keys[i]); }, results.begin());
+        });
+        std::cout << "interleave N=" << in_flight << (in_flight < 10 ? " " : "") << "      : " << interleaved << " ns/lookup, "
+                  << sequential / interleaved << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_kary.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+template <typename T>
+void compare(size_t count, size_t lookups, std::mt19937_64 &rng) {
+    std::vector<T> vec(count);
+    for (T &key : vec) {
+        key = static_cast<T>(rng() % (count * 4));
+    }
+    std::sort(vec.begin(), vec.end());
+    std::vector<T> queries(lookups);
+    for (T &query : queries) {
+        query = static_cast<T>(rng() % (count * 4));
+    }
+
+    size_t checksum[2] = {};
+    double const plain = measure(lookups, [&] {
+        for (T query : queries) {
+            checksum[0] += static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(vec, query) - vec.begin());
+        }
+    });
+    jrmwng::algorithm::simd::kary_schedule_t<jrmwng::algorithm::simd::kary_fanout_v<T>> const schedule(count);
+    double const kary = measure(lookups, [&] {
+        for (T query : queries) {
+            checksum[1] += static_cast<size_t>(jrmwng::algorithm::simd::kary_lower_bound(vec, query, schedule) - vec.begin());
+        }
+    });
+    std::cout << "  " << count << " keys: simd::lower_bound " << plain << " ns, kary_lower_bound (" << schedule.levels() << " levels) "
+              << kary << " ns (" << plain / kary << "x)" << (checksum[0] == checksum[1] ? "" : "  MISMATCH") << std::endl;
+}
+
+template <typename T, size_t N>
+void compare_fixed(size_t lookups, std::mt19937_64 &rng) {
+    std::array<T, N> node;
+    for (size_t i = 0; i < N; ++i) {
+        node[i] = static_cast<T>(i * 4);
+    }
+    std::vector<T> queries(lookups);
+    for (T &query : queries) {
+        query = static_cast<T>(rng() % (N * 4));
+    }
+
+    size_t checksum[2] = {};
+    double const plain = measure(lookups, [&] {
+        for (T query : queries) {
+            checksum[0] += static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(node, query) - node.begin());
+        }
+    });
+    double const kary = measure(lookups, [&] {
+        for (T query : queries) {
+            checksum[1] += static_cast<size_t>(jrmwng::algorithm::simd::kary_lower_bound(node, query) - node.begin());
+        }
+    });
+    std::cout << "  std::array<" << N << ">: simd::lower_bound " << plain << " ns, unrolled kary_lower_bound " << kary << " ns ("
+              << plain / kary << "x)" << (checksum[0] == checksum[1] ? "" : "  MISMATCH") << std::endl;
+}
+
+// Usage: lower_bound_bench_kary [max_keys=16777216] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const max_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    std::mt19937_64 rng(1);
+
+    std::cout << "int (K = 8)" << std::endl;
+    for (size_t count = 1000; count <= max_count; count *= 16) {
+        compare<int>(count, lookups, rng);
+    }
+    compare_fixed<int, 64>(lookups, rng);
+    compare_fixed<int, 512>(lookups, rng);
+    std::cout << "uint64_t (K = 4)" << std::endl;
+    for (size_t count = 1000; count <= max_count; count *= 16) {
+        compare<uint64_t>(count, lookups, rng);
+    }
+    compare_fixed<uint64_t, 64>(lookups, rng);
+    compare_fixed<uint64_t, 512>(lookups, rng);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <filesystem>
+#include "lower_bound_mapped.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_mapped [keys=67108864] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 26);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_bench_mapped.idx";
+
+    std::vector<uint64_t> keys(count);
+    std::mt19937_64 rng(1);
+    for (uint64_t &key : keys) {
+        key = rng();
+    }
+    std::vector<uint64_t> queries(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(std::min(lookups, count)));
+
+    size_t checksum[2] = {};
+    double const build = measure(1000000, [&] {
+        std::sort(keys.begin(), keys.end());
+        jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb(keys);
+        checksum[0] += veb.lower_bound(queries[0]);
+        jrmwng::algorithm::mapped::save<uint64_t>(path, keys, veb);
+    });
+    std::vector<uint64_t>().swap(keys);
+
+    double const load = measure(1000, [&] {
+        jrmwng::algorithm::mapped::index_t<uint64_t> index(path);
+        checksum[1] += index.lower_bound(queries[0]);
+    });
+    jrmwng::algorithm::mapped::index_t<uint64_t> index(path);
+    double const search = measure(queries.size(), [&] {
+        for (uint64_t query : queries) {
+            checksum[1] += index.lower_bound(query);
+        }
+    });
+    double const verify = measure(1000000, [&] {
+        checksum[1] += index.verify();
+    });
+
+    std::cout << count << " uint64_t keys with veb layout, " << std::filesystem::file_size(path) / (1024 * 1024) << " MB file" << std::endl;
+    std::cout << "sort + build + save: " << build << " ms; load: " << load << " us; verify: " << verify << " ms; "
+              << search << " ns/lookup after load" << (checksum[0] ? "" : " ") << std::endl;
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <optional>
+#include <string>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_two_level.hpp"
+#include "lower_bound_radix_spline.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+template <typename T>
+size_t index_bytes(jrmwng::algorithm::layout::two_level_index_t<T> const &index) {
+    return index.summary_bytes();
+}
+
+template <typename T>
+size_t index_bytes(jrmwng::algorithm::layout::radix_spline_t<T> const &index) {
+    return index.bytes();
+}
+
+// Usage: lower_bound_bench_radix_spline [keys=16777216] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    for (bool const skewed : {false, true}) {
+        std::mt19937_64 rng(1);
+        std::vector<uint64_t> vec(count);
+        for (uint64_t &key : vec) {
+            key = skewed ? static_cast<uint64_t>(std::exp2(std::ldexp(static_cast<double>(rng() >> 11), -53) * 60.0)) : rng();
+        }
+        std::sort(vec.begin(), vec.end());
+        std::vector<uint64_t> queries(lookups);
+        for (uint64_t &query : queries) {
+            query = vec[rng() % count] + (rng() & 1);
+        }
+        std::cout << count << (skewed ? " log-uniform" : " hashed (uniform)") << " uint64_t keys, " << lookups << " lookups" << std::endl;
+
+        size_t checksum[2] = {};
+        double const plain = measure(lookups, [&] {
+            for (uint64_t query : queries) {
+                checksum[0] += static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(vec, query) - vec.begin());
+            }
+        });
+        std::cout << "  simd::lower_bound: " << plain << " ns" << std::endl;
+
+        auto const report = [&](char const *name, auto const &index, double build) {
+            checksum[1] = 0;
+            double const ns = measure(lookups, [&] {
+                for (uint64_t query : queries) {
+                    checksum[1] += index.lower_bound(query);
+                }
+            });
+            std::cout << "  " << name << ": build " << build << " ms, " << index_bytes(index) / 1024 << " KB, " << ns << " ns ("
+                      << plain / ns << "x)" << (checksum[0] == checksum[1] ? "" : "  MISMATCH") << std::endl;
+        };
+        double build = 0;
+        {
+            std::optional<jrmwng::algorithm::layout::two_level_index_t<uint64_t>> index;
+            build = measure(1000000, [&] { index.emplace(vec); });
+            report("two_level_index_t", *index, build);
+        }
+        for (auto const &[radix_bits, spline_error] : {std::pair<size_t, size_t>{0, 0}, {18, 0}, {18, 32}, {18, 8}}) {
+            std::optional<jrmwng::algorithm::layout::radix_spline_t<uint64_t>> index;
+            build = measure(1000000, [&] { index.emplace(vec, radix_bits, spline_error); });
+            std::string const name = "radix_spline_t r=" + std::to_string(index->radix_bits()) + " E=" + std::to_string(spline_error)
+                                     + (spline_error ? " (" + std::to_string(index->knots()) + " knots)" : "");
+            report(name.c_str(), *index, build);
+        }
+    }
+    return 0;
+}
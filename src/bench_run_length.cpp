@@ -0,0 +1,55 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_run_length.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_run_length [rows=67108864] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 26);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::cout << rows << " int rows, " << lookups << " random equal_range lookups" << std::endl;
+    for (size_t distinct : {16, 1024, 65536}) {
+        std::vector<int> vec(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            vec[i] = static_cast<int>(i * distinct / rows);
+        }
+        jrmwng::algorithm::layout::run_length_t runs(vec);
+
+        std::vector<int> keys(lookups);
+        std::minstd_rand rng(1);
+        for (int &key : keys) {
+            key = static_cast<int>(rng() % distinct);
+        }
+
+        size_t checksum[2] = {};
+        double const dense = measure(lookups, [&] {
+            for (int key : keys) {
+                auto const first = jrmwng::algorithm::simd::lower_bound(vec, key);
+                auto const last = jrmwng::algorithm::simd::lower_bound(vec, key + 1);
+                checksum[0] += static_cast<size_t>(last - first);
+            }
+        });
+        double const encoded = measure(lookups, [&] {
+            for (int key : keys) {
+                auto const [first, last] = runs.equal_range(key);
+                checksum[1] += last - first;
+            }
+        });
+        std::cout << distinct << " distinct: plain vector " << runs.dense_bytes() / 1024 << " KB, " << dense << " ns; run_length_t "
+                  << runs.bytes() / 1024 << " KB (" << static_cast<double>(runs.dense_bytes()) / static_cast<double>(runs.bytes()) << "x smaller), "
+                  << encoded << " ns (" << dense / encoded << "x)" << (checksum[0] == checksum[1] ? "" : "  MISMATCH") << std::endl;
+    }
+    return 0;
+}
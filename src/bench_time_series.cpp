@@ -0,0 +1,100 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <cstdint>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_time_series.hpp"
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+// Usage: lower_bound_bench_time_series [events=16777216] [lookups=1000000]
+int main(int argc, char **argv) {
+    size_t const count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+    size_t const lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    // Event timestamps in nanoseconds, about 1000 events per millisecond.
+    std::mt19937_64 rng(1);
+    std::vector<int64_t> events(count);
+    int64_t now = 0;
+    for (int64_t &event : events) {
+        now += static_cast<int64_t>(rng() % 2000);
+        event = now;
+    }
+
+    jrmwng::algorithm::concurrent::time_series_t<int64_t> series(4096, (count >> 12) + 1);
+    double const append = measure(count, [&] {
+        for (int64_t event : events) {
+            series.append(event);
+        }
+    });
+    std::vector<int64_t> guarded;
+    std::mutex mutex;
+    double const locked_append = measure(count, [&] {
+        for (int64_t event : events) {
+            std::lock_guard<std::mutex> lock(mutex);
+            guarded.push_back(event);
+        }
+    });
+    std::cout << count << " events: append " << append << " ns/event; mutex + std::vector::push_back " << locked_append << " ns/event" << std::endl;
+
+    for (int64_t const window : {int64_t(1000000), int64_t(1000000000), now}) {
+        std::vector<int64_t> queries(lookups);
+        for (int64_t &query : queries) {
+            query = now - static_cast<int64_t>(rng() % static_cast<uint64_t>(window));
+        }
+        size_t checksum[3] = {};
+        double const plain = measure(lookups, [&] {
+            for (int64_t query : queries) {
+                checksum[0] += static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(events, query) - events.begin());
+            }
+        });
+        double const chunked = measure(lookups, [&] {
+            for (int64_t query : queries) {
+                checksum[1] += series.lower_bound(query);
+            }
+        });
+        double const recent = measure(lookups, [&] {
+            for (int64_t query : queries) {
+                checksum[2] += series.lower_bound_recent(query);
+            }
+        });
+        std::cout << "  latest " << window / 1000000 << " ms: simd::lower_bound on a vector " << plain << " ns; lower_bound " << chunked
+                  << " ns; lower_bound_recent " << recent << " ns" << (checksum[0] == checksum[1] && checksum[1] == checksum[2] ? "" : "  MISMATCH") << std::endl;
+    }
+
+    // Readers searching while the writer appends.
+    jrmwng::algorithm::concurrent::time_series_t<int64_t> live(4096, (count >> 12) + 1);
+    std::atomic<bool> done = false;
+    std::atomic<size_t> reads = 0;
+    std::thread reader([&] {
+        size_t local = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            size_t const size = live.size();
+            if (size) {
+                local += live.lower_bound_recent(live[size - 1] - 1000000) <= size;
+            }
+        }
+        reads = local;
+    });
+    double const live_append = measure(count, [&] {
+        for (int64_t event : events) {
+            live.append(event);
+        }
+    });
+    done = true;
+    reader.join();
+    std::cout << "append with a concurrent reader: " << live_append << " ns/event, " << reads.load() << " reads" << std::endl;
+    return 0;
+}
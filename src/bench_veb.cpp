@@ -0,0 +1,112 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <span>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_veb.hpp"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+template <typename Tfunction>
+double measure(size_t lookups, Tfunction fn) {
+    auto const begin = std::chrono::steady_clock::now();
+    fn();
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(lookups);
+}
+
+#if defined(__linux__)
+// Writes the ints to a file and maps it back read-only, so lookups are served from the page cache.
+class MappedInts {
+public:
+    MappedInts(std::string const &path, std::span<int const> data) : m_size(data.size_bytes()) {
+        int const fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0 || ::write(fd, data.data(), m_size) != static_cast<ssize_t>(m_size)) {
+            std::cerr << "cannot write " << path << std::endl;
+            std::exit(1);
+        }
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        ::unlink(path.c_str());
+    }
+    ~MappedInts() {
+        ::munmap(m_data, m_size);
+    }
+    std::span<int const> ints() const {
+        return {static_cast<int const *>(m_data), m_size / sizeof(int)};
+    }
+private:
+    size_t m_size;
+    void *m_data;
+};
+#endif
+
+static void run(std::string const &label, size_t size, size_t lookups, bool page_cache) {
+    std::vector<int> vec(size);
+    for (size_t i = 0; i < size; ++i) {
+        vec[i] = static_cast<int>(2 * i);
+    }
+    std::vector<int> keys(lookups);
+    std::minstd_rand rng(1);
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(2 * size));
+    for (int &key : keys) {
+        key = dist(rng);
+    }
+    jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+
+    std::span<int const> sorted = vec;
+    jrmwng::algorithm::layout::veb_view_t<int> view = veb.view();
+#if defined(__linux__)
+    std::unique_ptr<MappedInts> mapped_sorted;
+    std::unique_ptr<MappedInts> mapped_veb;
+    if (page_cache) {
+        mapped_sorted = std::make_unique<MappedInts>("lower_bound_bench_veb.sorted", vec);
+        mapped_veb = std::make_unique<MappedInts>("lower_bound_bench_veb.nodes", veb.view().nodes());
+        sorted = mapped_sorted->ints();
+        view = jrmwng::algorithm::layout::veb_view_t<int>(mapped_veb->ints(), size);
+    }
+#else
+    static_cast<void>(page_cache);
+#endif
+
+    size_t checksum[3] = {};
+    double const plain = measure(lookups, [&] {
+        for (int key : keys) {
+            checksum[0] += static_cast<size_t>(jrmwng::algorithm::ranges::lower_bound(sorted, key) - sorted.begin());
+        }
+    });
+    double const simd = measure(lookups, [&] {
+        for (int key : keys) {
+            checksum[1] += static_cast<size_t>(jrmwng::algorithm::simd::lower_bound(sorted, key) - sorted.begin());
+        }
+    });
+    double const veb_time = measure(lookups, [&] {
+        for (int key : keys) {
+            checksum[2] += view.lower_bound(key);
+        }
+    });
+    std::cout << label << " (" << size << " ints, vEB " << veb.bytes() / 1024 << " KB): ranges::lower_bound " << plain
+              << " ns, simd::lower_bound " << simd << " ns, veb_layout_t " << veb_time << " ns"
+              << (checksum[0] == checksum[1] && checksum[1] == checksum[2] ? "" : "  MISMATCH") << std::endl;
+}
+
+// Usage: lower_bound_bench_veb [lookups=1000000] [dram_elements=67108864]
+int main(int argc, char **argv) {
+    size_t const lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t const dram = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : (size_t(1) << 26);
+
+    run("L2        ", size_t(1) << 16, lookups, false);
+    run("LLC       ", size_t(1) << 21, lookups, false);
+    run("DRAM      ", dram, lookups, false);
+    run("page cache", dram, lookups, true);
+    return 0;
+}
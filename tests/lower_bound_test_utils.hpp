@@ -0,0 +1,28 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+// Checks shared by the tests of the search structures: each must find the lower bound std::lower_bound finds in the
+// sorted keys it was built from.
+
+/**
+ * Expects search(query) to find, for every query in order, the lower bound std::lower_bound finds in the sorted keys.
+ * search returns either the position of the lower bound or an iterator into keys.
+ */
+template <typename T, typename Search, typename Compare = std::less<>>
+void ExpectMatchesStd(std::vector<T> const &keys, std::vector<T> const &queries, Search &&search, Compare comp = {}) {
+    for (T const &query : queries) {
+        size_t const expected = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), query, comp) - keys.begin());
+        auto const result = search(query);
+        if constexpr (std::is_integral_v<std::remove_const_t<decltype(result)>>) {
+            EXPECT_EQ(static_cast<size_t>(result), expected) << query;
+        } else {
+            EXPECT_EQ(static_cast<size_t>(result - keys.begin()), expected) << query;
+        }
+    }
+}
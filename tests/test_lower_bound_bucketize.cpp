@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include "lower_bound_bucketize.hpp"
+
+template <typename T>
+static std::vector<size_t> ReferenceBucketize(std::vector<T> const &boundaries, std::vector<T> const &values) {
+    std::vector<size_t> buckets;
+    for (T const &value : values) {
+        buckets.push_back(static_cast<size_t>(std::lower_bound(boundaries.begin(), boundaries.end(), value) - boundaries.begin()));
+    }
+    return buckets;
+}
+
+template <typename T>
+static void ExpectMatchesReference(size_t boundary_count, size_t value_count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<T> boundaries(boundary_count);
+    for (auto &boundary : boundaries) {
+        boundary = static_cast<T>(rng() % 1000);
+    }
+    std::ranges::sort(boundaries);
+    std::vector<T> values(value_count);
+    for (auto &value : values) {
+        value = static_cast<T>(rng() % 1100) - static_cast<T>(50);
+    }
+    std::vector<size_t> buckets(values.size());
+    jrmwng::algorithm::simd::bucketize(boundaries, values, buckets);
+    EXPECT_EQ(buckets, ReferenceBucketize(boundaries, values)) << boundary_count << " boundaries";
+}
+
+TEST(LowerBoundBucketizeTest, Basic) {
+    std::vector<float> boundaries = {0.0f, 10.0f, 20.0f};
+    std::vector<float> values = {-1.0f, 5.0f, 10.0f, 25.0f};
+    std::vector<uint8_t> buckets(values.size());
+    jrmwng::algorithm::simd::bucketize(boundaries, values, buckets);
+    EXPECT_EQ(buckets, (std::vector<uint8_t>{0, 1, 1, 3}));
+}
+
+TEST(LowerBoundBucketizeTest, RegisterCounts) {
+    // Every register count, including partially filled last registers, and the fallback beyond the capacity.
+    for (size_t boundary_count = 1; boundary_count <= 80; ++boundary_count) {
+        ExpectMatchesReference<int>(boundary_count, 101, static_cast<uint32_t>(boundary_count));
+        ExpectMatchesReference<float>(boundary_count, 37, static_cast<uint32_t>(boundary_count));
+        ExpectMatchesReference<double>(boundary_count, 37, static_cast<uint32_t>(boundary_count));
+        ExpectMatchesReference<int64_t>(boundary_count, 37, static_cast<uint32_t>(boundary_count));
+    }
+}
+
+TEST(LowerBoundBucketizeTest, UnsignedAndDuplicates) {
+    std::vector<uint32_t> boundaries = {5, 5, 5, 0x80000000u, 0xFFFFFFF0u};
+    std::vector<uint32_t> values = {0, 5, 6, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu};
+    std::vector<uint32_t> buckets(values.size());
+    jrmwng::algorithm::simd::bucketize(boundaries, values, buckets);
+    EXPECT_EQ(buckets, (std::vector<uint32_t>{0, 0, 3, 3, 3, 5}));
+}
+
+TEST(LowerBoundBucketizeTest, EmptyInputs) {
+    std::vector<int> boundaries;
+    std::vector<int> values = {1, 2, 3};
+    std::vector<size_t> buckets(values.size(), 7);
+    jrmwng::algorithm::simd::bucketize(boundaries, values, buckets);
+    EXPECT_EQ(buckets, (std::vector<size_t>{0, 0, 0}));
+
+    std::vector<int> no_values;
+    std::vector<size_t> no_buckets;
+    jrmwng::algorithm::simd::bucketize(values, no_values, no_buckets);
+}
+
+TEST(LowerBoundBucketizeTest, ScalarType) {
+    std::vector<short> boundaries = {-3, 0, 4};
+    std::vector<short> values = {-5, -3, 1, 9};
+    std::vector<int> buckets(values.size());
+    jrmwng::algorithm::simd::bucketize(boundaries, values, buckets);
+    EXPECT_EQ(buckets, (std::vector<int>{0, 0, 2, 3}));
+}
+
+TEST(LowerBoundBucketizeTest, OutputTooShort) {
+    std::vector<int> boundaries = {1, 2};
+    std::vector<int> values = {1, 2, 3};
+    std::vector<size_t> buckets(2);
+    EXPECT_THROW(jrmwng::algorithm::simd::bucketize(boundaries, values, buckets), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
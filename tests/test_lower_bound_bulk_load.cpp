@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include "lower_bound_bulk_load.hpp"
+
+template <typename T, typename Tgenerate>
+static std::vector<T> Generate(size_t size, Tgenerate fnGenerate) {
+    std::mt19937_64 rng(size);
+    std::vector<T> vec(size);
+    for (T &x : vec) {
+        x = fnGenerate(rng);
+    }
+    return vec;
+}
+
+TEST(LowerBoundBulkLoadTest, Basic) {
+    std::vector<int> vec = {5, -3, 9, 0, -3, 7};
+    jrmwng::algorithm::bulk::sort(std::span<int>(vec));
+    EXPECT_EQ(vec, (std::vector<int>{-3, -3, 0, 5, 7, 9}));
+    vec.resize(jrmwng::algorithm::bulk::unique(std::span<int>(vec)));
+    EXPECT_EQ(vec, (std::vector<int>{-3, 0, 5, 7, 9}));
+}
+
+TEST(LowerBoundBulkLoadTest, Empty) {
+    std::vector<uint64_t> vec;
+    jrmwng::algorithm::bulk::sort(std::span<uint64_t>(vec), 4);
+    EXPECT_EQ(jrmwng::algorithm::bulk::unique(std::span<uint64_t>(vec), 4), 0u);
+    EXPECT_TRUE(jrmwng::algorithm::bulk::load(std::span<uint64_t const>(vec), {.dedupe = true}).empty());
+}
+
+TEST(LowerBoundBulkLoadTest, RadixSortMatchesStd) {
+    for (size_t size : {1u, 63u, 1000u, 300000u}) {
+        for (size_t threads : {1u, 4u}) {
+            SCOPED_TRACE(testing::Message() << size << " keys, " << threads << " threads");
+            std::vector<int> ints = Generate<int>(size, [](auto &rng) { return static_cast<int>(rng()); });
+            std::vector<int> expected_ints = ints;
+            std::sort(expected_ints.begin(), expected_ints.end());
+            jrmwng::algorithm::bulk::sort(std::span<int>(ints), threads);
+            EXPECT_EQ(ints, expected_ints);
+            std::vector<int64_t> int64s = Generate<int64_t>(size, [](auto &rng) { return static_cast<int64_t>(rng()) >> (rng() % 64); });
+            std::vector<int64_t> expected_int64s = int64s;
+            std::sort(expected_int64s.begin(), expected_int64s.end());
+            jrmwng::algorithm::bulk::sort(std::span<int64_t>(int64s), threads);
+            EXPECT_EQ(int64s, expected_int64s);
+            std::vector<uint64_t> uint64s = Generate<uint64_t>(size, [](auto &rng) { return rng(); });
+            std::vector<uint64_t> expected_uint64s = uint64s;
+            std::sort(expected_uint64s.begin(), expected_uint64s.end());
+            jrmwng::algorithm::bulk::sort(std::span<uint64_t>(uint64s), threads);
+            EXPECT_EQ(uint64s, expected_uint64s);
+            std::vector<uint32_t> uint32s = Generate<uint32_t>(size, [](auto &rng) { return static_cast<uint32_t>(rng() % 300); });
+            std::vector<uint32_t> expected_uint32s = uint32s;
+            std::sort(expected_uint32s.begin(), expected_uint32s.end());
+            jrmwng::algorithm::bulk::sort(std::span<uint32_t>(uint32s), threads);
+            EXPECT_EQ(uint32s, expected_uint32s);
+            std::vector<float> floats = Generate<float>(size, [](auto &rng) { return std::uniform_real_distribution<float>(-1e6f, 1e6f)(rng); });
+            std::vector<float> expected_floats = floats;
+            std::sort(expected_floats.begin(), expected_floats.end());
+            jrmwng::algorithm::bulk::sort(std::span<float>(floats), threads);
+            EXPECT_EQ(floats, expected_floats);
+            std::vector<double> doubles = Generate<double>(size, [](auto &rng) { return std::exponential_distribution<double>(0.5)(rng); });
+            std::vector<double> expected_doubles = doubles;
+            std::sort(expected_doubles.begin(), expected_doubles.end());
+            jrmwng::algorithm::bulk::sort(std::span<double>(doubles), threads);
+            EXPECT_EQ(doubles, expected_doubles);
+        }
+    }
+}
+
+TEST(LowerBoundBulkLoadTest, SkewedAndConstantKeys) {
+    // One dominant bucket, and keys whose low bytes all agree.
+    std::vector<uint64_t> dominant = Generate<uint64_t>(300000, [](auto &rng) { return rng() % 16 == 0 ? rng() : rng() % 1000; });
+    std::vector<uint64_t> expected_dominant = dominant;
+    std::sort(expected_dominant.begin(), expected_dominant.end());
+    jrmwng::algorithm::bulk::sort(std::span<uint64_t>(dominant), 4);
+    EXPECT_EQ(dominant, expected_dominant);
+    std::vector<uint64_t> high_bytes = Generate<uint64_t>(300000, [](auto &rng) { return (rng() % 1000) << 40; });
+    std::vector<uint64_t> expected_high_bytes = high_bytes;
+    std::sort(expected_high_bytes.begin(), expected_high_bytes.end());
+    jrmwng::algorithm::bulk::sort(std::span<uint64_t>(high_bytes), 4);
+    EXPECT_EQ(high_bytes, expected_high_bytes);
+    std::vector<int> constant(300000, 42);
+    jrmwng::algorithm::bulk::sort(std::span<int>(constant), 4);
+    EXPECT_EQ(constant, std::vector<int>(300000, 42));
+}
+
+TEST(LowerBoundBulkLoadTest, ComparatorMergeSort) {
+    for (size_t size : {1000u, 300001u}) {
+        std::vector<int> vec = Generate<int>(size, [](auto &rng) { return static_cast<int>(rng() % 100000); });
+        std::vector<int> expected = vec;
+        std::sort(expected.begin(), expected.end(), std::greater<int>());
+        for (size_t threads : {1u, 3u, 4u}) {
+            std::vector<int> sorted = vec;
+            jrmwng::algorithm::bulk::sort(std::span<int>(sorted), threads, std::greater<int>());
+            EXPECT_EQ(sorted, expected) << size << " keys, " << threads << " threads";
+        }
+    }
+}
+
+TEST(LowerBoundBulkLoadTest, UniqueAcrossChunks) {
+    // Runs of duplicates longer than a chunk straddle several threads' shares.
+    std::vector<uint32_t> vec = Generate<uint32_t>(400000, [](auto &rng) { return static_cast<uint32_t>(rng() % 5); });
+    std::sort(vec.begin(), vec.end());
+    std::vector<uint32_t> expected = vec;
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+    vec.resize(jrmwng::algorithm::bulk::unique(std::span<uint32_t>(vec), 4));
+    EXPECT_EQ(vec, expected);
+
+    std::vector<int> input = Generate<int>(300000, [](auto &rng) { return static_cast<int>(rng() % 50000); });
+    std::vector<int> deduped = jrmwng::algorithm::bulk::load(std::span<int const>(input), {.threads = 4, .dedupe = true});
+    std::sort(input.begin(), input.end());
+    input.erase(std::unique(input.begin(), input.end()), input.end());
+    EXPECT_EQ(deduped, input);
+}
+
+TEST(LowerBoundBulkLoadTest, LoadFromFile) {
+    auto const path = std::filesystem::temp_directory_path() / "test_lower_bound_bulk_load.bin";
+    std::vector<uint64_t> keys = Generate<uint64_t>(300000, [](auto &rng) { return rng() % 100000; });
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs.write(reinterpret_cast<char const *>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(uint64_t)));
+    }
+    std::vector<uint64_t> loaded = jrmwng::algorithm::bulk::load<uint64_t>(path, {.threads = 4});
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(loaded, keys);
+    loaded = jrmwng::algorithm::bulk::load<uint64_t>(path, {.threads = 4, .dedupe = true});
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    EXPECT_EQ(loaded, keys);
+
+    std::filesystem::resize_file(path, 12);
+    EXPECT_THROW(jrmwng::algorithm::bulk::load<uint64_t>(path), std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(jrmwng::algorithm::bulk::load<uint64_t>(path), std::filesystem::filesystem_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
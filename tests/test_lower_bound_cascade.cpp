@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <cstdint>
+#include "lower_bound_cascade.hpp"
+
+TEST(LowerBoundCascadeTest, Basic) {
+    std::vector<std::vector<int>> runs = {{1, 5, 9}, {2, 3, 5, 7}, {4, 8}};
+    jrmwng::algorithm::layout::cascade_t cascade(runs);
+    EXPECT_EQ(cascade.lower_bound(5), (std::vector<size_t>{1, 2, 1}));
+    EXPECT_EQ(cascade.lower_bound(0), (std::vector<size_t>{0, 0, 0}));
+    EXPECT_EQ(cascade.lower_bound(10), (std::vector<size_t>{3, 4, 2}));
+}
+
+TEST(LowerBoundCascadeTest, RandomRuns) {
+    std::mt19937 rng(3);
+    for (size_t sample : {2, 3, 4, 8}) {
+        std::vector<std::vector<int>> runs(7);
+        for (size_t i = 0; i < runs.size(); ++i) {
+            runs[i].resize(rng() % 3000);
+            for (int &key : runs[i]) {
+                key = static_cast<int>(rng() % 5000);
+            }
+            std::sort(runs[i].begin(), runs[i].end());
+        }
+        std::vector<int> queries;
+        for (int query = -2; query <= 5002; query += 3) {
+            queries.push_back(query);
+        }
+        jrmwng::algorithm::layout::cascade_t<int> cascade(runs, sample);
+        ASSERT_EQ(cascade.runs(), runs.size());
+        for (int query : queries) {
+            std::vector<size_t> const positions = cascade.lower_bound(query);
+            for (size_t i = 0; i < runs.size(); ++i) {
+                EXPECT_EQ(positions[i], static_cast<size_t>(std::ranges::lower_bound(runs[i], query) - runs[i].begin()))
+                    << "run " << i << ", sample " << sample << ", query " << query;
+            }
+        }
+    }
+}
+
+TEST(LowerBoundCascadeTest, DuplicatesAndEmptyRuns) {
+    std::vector<std::vector<uint32_t>> runs = {{}, {5, 5, 5, 5, 5, 5, 5, 5, 5}, {1, 5, 5, 5, 9}, {}, {5, 5}, {0, 0, 10}};
+    for (size_t sample : {2u, 4u}) {
+        jrmwng::algorithm::layout::cascade_t<uint32_t> cascade(runs, sample);
+        EXPECT_EQ(cascade.lower_bound(0), (std::vector<size_t>{0, 0, 0, 0, 0, 0}));
+        EXPECT_EQ(cascade.lower_bound(1), (std::vector<size_t>{0, 0, 0, 0, 0, 2}));
+        EXPECT_EQ(cascade.lower_bound(5), (std::vector<size_t>{0, 0, 1, 0, 0, 2}));
+        EXPECT_EQ(cascade.lower_bound(6), (std::vector<size_t>{0, 9, 4, 0, 2, 2}));
+        EXPECT_EQ(cascade.lower_bound(10), (std::vector<size_t>{0, 9, 5, 0, 2, 2}));
+        EXPECT_EQ(cascade.lower_bound(11), (std::vector<size_t>{0, 9, 5, 0, 2, 3}));
+    }
+}
+
+TEST(LowerBoundCascadeTest, Descending) {
+    std::vector<std::vector<double>> runs = {{9.0, 7.5, 1.0}, {8.0, 8.0, 2.0, -1.0}, {10.0, 0.5}};
+    jrmwng::algorithm::layout::cascade_t<double, std::greater<double>> cascade(runs, 2);
+    EXPECT_EQ(cascade.lower_bound(11.0), (std::vector<size_t>{0, 0, 0}));
+    EXPECT_EQ(cascade.lower_bound(9.0), (std::vector<size_t>{0, 0, 1}));
+    EXPECT_EQ(cascade.lower_bound(8.0), (std::vector<size_t>{1, 0, 1}));
+    EXPECT_EQ(cascade.lower_bound(7.0), (std::vector<size_t>{2, 2, 1}));
+    EXPECT_EQ(cascade.lower_bound(2.0), (std::vector<size_t>{2, 2, 1}));
+    EXPECT_EQ(cascade.lower_bound(0.0), (std::vector<size_t>{3, 3, 2}));
+    EXPECT_EQ(cascade.lower_bound(-5.0), (std::vector<size_t>{3, 4, 2}));
+}
+
+TEST(LowerBoundCascadeTest, SpansAndNoRuns) {
+    std::vector<int> first = {1, 2, 3};
+    std::vector<int> second = {2, 4};
+    std::vector<std::span<int const>> runs = {first, second};
+    jrmwng::algorithm::layout::cascade_t<int> cascade(runs);
+    EXPECT_EQ(cascade.lower_bound(2), (std::vector<size_t>{1, 0}));
+
+    std::vector<std::vector<int>> none;
+    jrmwng::algorithm::layout::cascade_t<int> empty(none);
+    EXPECT_EQ(empty.runs(), 0u);
+    EXPECT_TRUE(empty.lower_bound(1).empty());
+}
+
+TEST(LowerBoundCascadeTest, SpaceBound) {
+    std::vector<std::vector<int>> runs(8, std::vector<int>(1000));
+    for (size_t i = 0; i < runs.size(); ++i) {
+        for (size_t j = 0; j < runs[i].size(); ++j) {
+            runs[i][j] = static_cast<int>(j * 8 + i);
+        }
+    }
+    jrmwng::algorithm::layout::cascade_t<int> cascade(runs, 4);
+    // Each augmented run holds at most its run plus a quarter of the next augmented run: below 4/3 of the total.
+    EXPECT_LE(cascade.augmented_size() * 3, 8000u * 4);
+    EXPECT_THROW((jrmwng::algorithm::layout::cascade_t<int>(runs, 1)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
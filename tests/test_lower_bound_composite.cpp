@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <tuple>
+#include <string>
+#include <algorithm>
+#include "lower_bound_composite.hpp"
+
+template <typename... Ts>
+static size_t ReferenceLowerBound(std::vector<std::tuple<Ts...>> const &rows, std::tuple<Ts...> const &key) {
+    return static_cast<size_t>(std::ranges::lower_bound(rows, key) - rows.begin());
+}
+
+TEST(LowerBoundCompositeTest, TenantTimestamp) {
+    std::vector<int> tenant = {1, 1, 2, 2};
+    std::vector<int64_t> timestamp = {10, 20, 5, 15};
+    jrmwng::algorithm::composite::columns_t columns(tenant, timestamp);
+    EXPECT_EQ(columns.lower_bound(0, int64_t(100)), 0u);
+    EXPECT_EQ(columns.lower_bound(1, int64_t(10)), 0u);
+    EXPECT_EQ(columns.lower_bound(1, int64_t(11)), 1u);
+    EXPECT_EQ(columns.lower_bound(1, int64_t(21)), 2u);
+    EXPECT_EQ(columns.lower_bound(2, int64_t(10)), 3u);
+    EXPECT_EQ(columns.lower_bound(2, int64_t(16)), 4u);
+    EXPECT_EQ(columns.lower_bound(3, int64_t(0)), 4u);
+}
+
+TEST(LowerBoundCompositeTest, EmptyColumns) {
+    std::vector<int> tenant;
+    std::vector<int64_t> timestamp;
+    jrmwng::algorithm::composite::columns_t columns(tenant, timestamp);
+    EXPECT_EQ(columns.lower_bound(1, int64_t(1)), 0u);
+}
+
+TEST(LowerBoundCompositeTest, RandomMatchesTupleOrder) {
+    std::mt19937 rng(3);
+    std::vector<std::tuple<int, int64_t>> rows(5000);
+    for (auto &row : rows) {
+        row = {static_cast<int>(rng() % 40) - 20, static_cast<int64_t>(rng() % 200)};
+    }
+    std::ranges::sort(rows);
+    std::vector<int> tenant;
+    std::vector<int64_t> timestamp;
+    for (auto const &[t, ts] : rows) {
+        tenant.push_back(t);
+        timestamp.push_back(ts);
+    }
+    jrmwng::algorithm::composite::columns_t columns(tenant, timestamp);
+    for (int t = -22; t < 22; ++t) {
+        for (int64_t ts = -1; ts < 202; ts += 13) {
+            EXPECT_EQ(columns.lower_bound(t, ts), ReferenceLowerBound(rows, std::tuple<int, int64_t>{t, ts})) << t << ", " << ts;
+        }
+    }
+}
+
+TEST(LowerBoundCompositeTest, ThreeColumnsMixedTypes) {
+    std::mt19937 rng(5);
+    std::vector<std::tuple<float, int, double>> rows(3000);
+    for (auto &row : rows) {
+        row = {static_cast<float>(rng() % 5) * 0.5f, static_cast<int>(rng() % 7), static_cast<double>(rng() % 11) * 0.25};
+    }
+    std::ranges::sort(rows);
+    std::vector<float> c0;
+    std::vector<int> c1;
+    std::vector<double> c2;
+    for (auto const &[a, b, c] : rows) {
+        c0.push_back(a);
+        c1.push_back(b);
+        c2.push_back(c);
+    }
+    jrmwng::algorithm::composite::columns_t columns(c0, c1, c2);
+    for (float a : {-0.5f, 0.0f, 1.0f, 1.25f, 2.0f, 3.0f}) {
+        for (int b = -1; b < 9; b += 2) {
+            for (double c : {-1.0, 0.0, 1.25, 2.6, 5.0}) {
+                EXPECT_EQ(columns.lower_bound(a, b, c), ReferenceLowerBound(rows, std::tuple<float, int, double>{a, b, c}));
+            }
+        }
+    }
+}
+
+TEST(LowerBoundCompositeTest, ScalarColumns) {
+    std::vector<std::string> names = {"a", "a", "b", "c", "c"};
+    std::vector<int> versions = {1, 3, 2, 0, 9};
+    jrmwng::algorithm::composite::columns_t columns(names, versions);
+    EXPECT_EQ(columns.lower_bound(std::string("a"), 2), 1u);
+    EXPECT_EQ(columns.lower_bound(std::string("c"), 1), 4u);
+
+    std::vector<int> leading = {1, 2, 2, 3};
+    std::vector<std::string> trailing = {"z", "a", "m", "b"};
+    jrmwng::algorithm::composite::columns_t mixed(leading, trailing);
+    EXPECT_EQ(mixed.lower_bound(2, std::string("b")), 2u);
+    EXPECT_EQ(mixed.lower_bound(2, std::string("n")), 3u);
+}
+
+TEST(LowerBoundCompositeTest, SingleColumn) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    jrmwng::algorithm::composite::columns_t columns(vec);
+    EXPECT_EQ(columns.lower_bound(3), 2u);
+    EXPECT_EQ(columns.lower_bound(7), 5u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
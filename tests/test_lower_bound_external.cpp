@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include "lower_bound_external.hpp"
+#include "lower_bound_test_utils.hpp"
+
+template <typename T>
+static std::vector<T> MakeQueries(std::vector<T> const &keys, size_t count) {
+    std::mt19937_64 rng(7);
+    std::vector<T> queries;
+    for (size_t i = 0; i < count; ++i) {
+        T const key = keys.empty() ? T(0) : keys[rng() % keys.size()];
+        queries.push_back(key);
+        queries.push_back(static_cast<T>(key + 1));
+    }
+    queries.push_back(std::numeric_limits<T>::lowest());
+    queries.push_back(std::numeric_limits<T>::max());
+    return queries;
+}
+
+TEST(LowerBoundExternalTest, Basic) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_basic.bpt";
+    std::vector<int> keys = {1, 3, 3, 5, 8};
+    EXPECT_EQ(jrmwng::algorithm::external::bulk_load(path, keys), keys.size());
+
+    jrmwng::algorithm::external::btree_reader_t<int> reader(path);
+    EXPECT_EQ(reader.height(), 1u);
+    EXPECT_EQ(reader.lower_bound(3), 1u);
+    EXPECT_EQ(reader.lower_bound(4), 3u);
+    EXPECT_EQ(reader.lower_bound(9), 5u);
+    EXPECT_EQ(reader.lower_bound(0), 0u);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, Empty) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_empty.bpt";
+    std::vector<int> keys;
+    jrmwng::algorithm::external::bulk_load(path, keys);
+
+    jrmwng::algorithm::external::btree_reader_t<int> reader(path);
+    EXPECT_EQ(reader.size(), 0u);
+    EXPECT_EQ(reader.height(), 0u);
+    EXPECT_EQ(reader.lower_bound(1), 0u);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, ThreeLevelsPread) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_pread.bpt";
+    // 512 keys per leaf: 600000 keys make 1172 leaves, 3 inner nodes and a root.
+    std::vector<uint64_t> keys(600000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = 3 * i + (i % 7 == 0);
+    }
+    jrmwng::algorithm::external::bulk_load(path, keys);
+
+    jrmwng::algorithm::external::reader_options options;
+    options.backend = jrmwng::algorithm::external::io_backend::pread;
+    options.cache_pages = 8; // Smaller than the tree: exercises eviction.
+    jrmwng::algorithm::external::btree_reader_t<uint64_t> reader(path, options);
+    ASSERT_EQ(reader.size(), keys.size());
+    std::vector<uint64_t> const queries = MakeQueries(keys, 2000);
+    std::vector<size_t> results(queries.size());
+    reader.lower_bound(queries, results);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(results[i], static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), queries[i]) - keys.begin())) << queries[i];
+    }
+    ExpectMatchesStd(keys, queries, [&](uint64_t query) { return reader.lower_bound(query); });
+    EXPECT_EQ(reader.height(), 3u);
+    EXPECT_FALSE(reader.uses_io_uring());
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, IoUring) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_io_uring.bpt";
+    std::vector<int> keys(300000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(2 * i) - 100000;
+    }
+    jrmwng::algorithm::external::bulk_load(path, keys);
+
+    jrmwng::algorithm::external::reader_options options;
+    options.backend = jrmwng::algorithm::external::io_backend::io_uring;
+    options.cache_pages = 16;
+    options.queue_depth = 8; // Fewer entries than the misses of a batch: exercises resubmission.
+    if (!jrmwng::algorithm::external::details::io_uring_t(options.queue_depth).valid()) {
+        std::filesystem::remove(path);
+        GTEST_SKIP() << "io_uring is unavailable";
+    }
+    jrmwng::algorithm::external::btree_reader_t<int> reader(path, options);
+    ASSERT_EQ(reader.size(), keys.size());
+    std::vector<int> const queries = MakeQueries(keys, 2000);
+    std::vector<size_t> results(queries.size());
+    reader.lower_bound(queries, results);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(results[i], static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), queries[i]) - keys.begin())) << queries[i];
+    }
+    ExpectMatchesStd(keys, queries, [&](int query) { return reader.lower_bound(query); });
+    EXPECT_TRUE(reader.uses_io_uring());
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, IoUringReapsEveryReadBeforeThrowing) {
+    jrmwng::algorithm::external::details::io_uring_t ring(4);
+    if (!ring.valid()) {
+        GTEST_SKIP() << "io_uring is unavailable";
+    }
+    // Reading a directory fails with EISDIR; a batch larger than the ring fails on every entry.
+    std::vector<jrmwng::algorithm::external::details::page_t> pages(6);
+    std::vector<jrmwng::algorithm::external::details::read_request_t> requests;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        requests.push_back({i, &pages[i]});
+    }
+    jrmwng::algorithm::external::details::file_t const directory(std::filesystem::temp_directory_path(), O_RDONLY, "cannot open");
+    EXPECT_THROW(ring.read(directory.get(), requests), std::system_error);
+
+    // The ring is left empty, so the next batch sees only its own completions.
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_io_uring_error.bpt";
+    std::vector<int> keys(20000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(i);
+    }
+    jrmwng::algorithm::external::bulk_load(path, keys);
+    {
+        jrmwng::algorithm::external::details::file_t const file(path, O_RDONLY, "cannot open");
+        ring.read(file.get(), requests);
+        for (size_t i = 1; i < 5; ++i) {
+            int first = 0;
+            std::memcpy(&first, pages[i].bytes, sizeof(first));
+            EXPECT_EQ(first, static_cast<int>((i - 1) * (jrmwng::algorithm::external::page_size_v / sizeof(int))));
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, CacheHitsAndReads) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_cache.bpt";
+    std::vector<int> keys(1024 * 10);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(i);
+    }
+    jrmwng::algorithm::external::bulk_load(path, keys);
+
+    jrmwng::algorithm::external::btree_reader_t<int> reader(path);
+    ASSERT_EQ(reader.height(), 2u);
+    EXPECT_EQ(reader.lower_bound(5), 5u);
+    EXPECT_EQ(reader.page_reads(), 2u);
+    EXPECT_EQ(reader.lower_bound(6), 6u);
+    EXPECT_EQ(reader.page_reads(), 2u);
+    EXPECT_EQ(reader.cache_hits(), 2u);
+
+    // One batch over every leaf reads each missing page once.
+    std::vector<int> queries = {0, 1025, 2050, 3075, 4100, 5125, 6150, 7175, 8200, 9225, 9226};
+    std::vector<size_t> results(queries.size());
+    reader.lower_bound(queries, results);
+    EXPECT_EQ(reader.page_reads(), 2u + 9u);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(results[i], static_cast<size_t>(queries[i]));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, Double) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_double.bpt";
+    std::vector<double> keys(5000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = 0.5 * static_cast<double>(i);
+    }
+    jrmwng::algorithm::external::bulk_load(path, keys);
+    jrmwng::algorithm::external::reader_options options;
+    jrmwng::algorithm::external::btree_reader_t<double> reader(path, options);
+    ASSERT_EQ(reader.size(), keys.size());
+    std::vector<double> const queries = MakeQueries(keys, 500);
+    std::vector<size_t> results(queries.size());
+    reader.lower_bound(queries, results);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(results[i], static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), queries[i]) - keys.begin())) << queries[i];
+    }
+    ExpectMatchesStd(keys, queries, [&](double query) { return reader.lower_bound(query); });
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, RejectsUnsortedInput) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_unsorted.bpt";
+    std::vector<int> keys = {1, 3, 2};
+    EXPECT_THROW(jrmwng::algorithm::external::bulk_load(path, keys), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundExternalTest, RejectsMismatchedFiles) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_mismatch.bpt";
+    std::vector<int> keys = {1, 2, 3};
+    jrmwng::algorithm::external::bulk_load(path, keys);
+    EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<float>{path}, std::runtime_error);
+    EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<uint32_t>{path}, std::runtime_error);
+
+    std::FILE *file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fputs("garbage", file);
+    std::fclose(file);
+    EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<int>{path}, std::runtime_error);
+
+    std::filesystem::resize_file(path, 100);
+    EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<int>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<int>{path}, std::system_error);
+}
+
+TEST(LowerBoundExternalTest, RejectsInconsistentHeaders) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_external_header.bpt";
+    std::vector<uint32_t> keys(100000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<uint32_t>(i);
+    }
+    jrmwng::algorithm::external::bulk_load(path, keys);
+    jrmwng::algorithm::external::details::file_header_t original;
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fread(&original, sizeof(original), 1, file), 1u);
+        std::fclose(file);
+    }
+    auto const expect_rejected = [&](auto mutate) {
+        jrmwng::algorithm::external::details::file_header_t header = original;
+        mutate(header);
+        std::FILE *file = std::fopen(path.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fclose(file);
+        EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<uint32_t>{path}, std::runtime_error);
+    };
+    using header_t = jrmwng::algorithm::external::details::file_header_t;
+    expect_rejected([](header_t &header) { header.keys_per_page = 512; });
+    expect_rejected([](header_t &header) { header.count += 1024; });
+    expect_rejected([](header_t &header) { header.count = 0; });
+    expect_rejected([](header_t &header) { header.levels = 1; });
+    expect_rejected([](header_t &header) { header.level_first[1] += 1; });
+    expect_rejected([](header_t &header) { header.level_pages[0] -= 1; });
+
+    // The unmodified header is accepted, but not once the file lost its root page.
+    {
+        std::FILE *file = std::fopen(path.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        std::fwrite(&original, sizeof(original), 1, file);
+        std::fclose(file);
+    }
+    EXPECT_NO_THROW(jrmwng::algorithm::external::btree_reader_t<uint32_t>{path});
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - jrmwng::algorithm::external::page_size_v);
+    EXPECT_THROW(jrmwng::algorithm::external::btree_reader_t<uint32_t>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
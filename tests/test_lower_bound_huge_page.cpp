@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <cstdint>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_huge_page.hpp"
+#include "lower_bound_two_level.hpp"
+#include "lower_bound_radix_spline.hpp"
+#include "lower_bound_cascade.hpp"
+#include "lower_bound_time_series.hpp"
+#include "lower_bound_snapshot.hpp"
+
+TEST(LowerBoundHugePageTest, SmallAllocationIsCacheLineAligned) {
+    jrmwng::algorithm::memory::huge_page_allocator<int> alloc;
+    for (size_t count : {1, 3, 16, 1000}) {
+        int *p = alloc.allocate(count);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % jrmwng::algorithm::memory::cache_line_size_v, 0u);
+        p[0] = 1;
+        p[count - 1] = 2;
+        alloc.deallocate(p, count);
+    }
+}
+
+TEST(LowerBoundHugePageTest, LargeAllocationIsHugePageAligned) {
+    jrmwng::algorithm::memory::huge_page_allocator<double> alloc;
+    size_t const count = jrmwng::algorithm::memory::huge_page_size_v / sizeof(double) * 3 + 5;
+    double *p = alloc.allocate(count);
+#if defined(__linux__)
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % jrmwng::algorithm::memory::huge_page_size_v, 0u);
+#else
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % jrmwng::algorithm::memory::cache_line_size_v, 0u);
+#endif
+    p[0] = 1.0;
+    p[count - 1] = 2.0;
+    EXPECT_EQ(p[count - 1], 2.0);
+    alloc.deallocate(p, count);
+}
+
+TEST(LowerBoundHugePageTest, ExplicitPagesFallBack) {
+    // Most machines reserve no explicit huge pages, so this exercises the fallback path.
+    jrmwng::algorithm::memory::huge_page_allocator<int, jrmwng::algorithm::memory::huge_page_policy::explicit_pages> alloc;
+    size_t const count = jrmwng::algorithm::memory::huge_page_size_v / sizeof(int) + 1;
+    int *p = alloc.allocate(count);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % jrmwng::algorithm::memory::cache_line_size_v, 0u);
+    p[count - 1] = 7;
+    EXPECT_EQ(p[count - 1], 7);
+    alloc.deallocate(p, count);
+}
+
+TEST(LowerBoundHugePageTest, OverflowThrows) {
+    jrmwng::algorithm::memory::huge_page_allocator<int64_t> alloc;
+    EXPECT_THROW(alloc.allocate(SIZE_MAX / 4), std::bad_alloc);
+}
+
+TEST(LowerBoundHugePageTest, VectorSimdIntegers) {
+    jrmwng::algorithm::memory::huge_page_vector<int> vec(size_t(1) << 20);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i * 2);
+    }
+    std::vector<int> test_values = {-1, 0, 1, 2, 4097, 2097150, 2097151};
+    for (int value : test_values) {
+        auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, value);
+        EXPECT_EQ(it_simd, std::ranges::lower_bound(vec, value));
+    }
+}
+
+TEST(LowerBoundHugePageTest, VectorSimdDoubles) {
+    jrmwng::algorithm::memory::huge_page_vector<double, jrmwng::algorithm::memory::huge_page_policy::explicit_pages> vec_d = {1.1, 2.2, 4.4, 5.5, 6.6};
+    auto it_d_simd = jrmwng::algorithm::simd::lower_bound(vec_d, 3.3);
+    EXPECT_EQ(it_d_simd, vec_d.begin() + 2);
+}
+
+TEST(LowerBoundHugePageTest, RebindForNodeContainers) {
+    std::list<int, jrmwng::algorithm::memory::huge_page_allocator<int>> list = {1, 2, 3};
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_EQ(list.back(), 3);
+}
+
+TEST(LowerBoundHugePageTest, IndexTypesTakeTheAllocator) {
+    std::vector<int64_t> vec(100000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int64_t>(i) * 3;
+    }
+    jrmwng::algorithm::layout::two_level_index_t<int64_t, jrmwng::algorithm::memory::huge_page_allocator<int16_t>> two_level(vec);
+    EXPECT_EQ(two_level.lower_bound(3001), 1001u);
+    jrmwng::algorithm::layout::radix_spline_t<int64_t, uint32_t, jrmwng::algorithm::memory::huge_page_allocator<uint32_t>> spline(vec, 20, 8);
+    EXPECT_EQ(spline.lower_bound(3001), 1001u);
+
+    std::vector<std::vector<int64_t>> runs = {vec, {5, 3001, 3002}};
+    jrmwng::algorithm::layout::cascade_t<int64_t, std::less<int64_t>, jrmwng::algorithm::memory::huge_page_allocator<int64_t>> cascade(runs);
+    EXPECT_EQ(cascade.lower_bound(3001), (std::vector<size_t>{1001, 1}));
+
+    jrmwng::algorithm::concurrent::time_series_t<int64_t, std::less<int64_t>, jrmwng::algorithm::memory::huge_page_allocator<int64_t>> series(size_t(1) << 18, 4);
+    series.append(vec);
+    EXPECT_EQ(series.lower_bound(3001), 1001u);
+
+    // snapshot_t holds whatever container it is given, so a huge_page_vector backs every snapshot.
+    jrmwng::algorithm::concurrent::snapshot_t<jrmwng::algorithm::memory::huge_page_vector<int64_t>> snapshot({1, 5, 9});
+    EXPECT_EQ(snapshot.lower_bound(int64_t(6)), 2u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include "lower_bound_interleave.hpp"
+
+TEST(LowerBoundInterleaveTest, SingleLookup) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    auto task = jrmwng::algorithm::interleave::lower_bound(vec, 3);
+    while (!task.step()) {
+    }
+    EXPECT_EQ(task.result(), 2u);
+}
+
+TEST(LowerBoundInterleaveTest, EmptyVector) {
+    std::vector<int> empty_vec;
+    auto task = jrmwng::algorithm::interleave::lower_bound(empty_vec, 1);
+    EXPECT_TRUE(task.step());
+    EXPECT_EQ(task.result(), 0u);
+}
+
+TEST(LowerBoundInterleaveTest, RunMatchesStdForEveryInFlightCount) {
+    std::vector<int> vec(10000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i / 2) * 3;
+    }
+    std::vector<int> keys;
+    for (int key = -5; key < 15010; key += 7) {
+        keys.push_back(key);
+    }
+    std::vector<size_t> expected(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        expected[i] = static_cast<size_t>(std::ranges::lower_bound(vec, keys[i]) - vec.begin());
+    }
+
+    for (size_t in_flight : {1, 4, 8, 16, 32, 100000}) {
+        std::vector<size_t> results(keys.size(), SIZE_MAX);
+        jrmwng::algorithm::interleave::run(in_flight, keys.size(), [&](size_t i) { return jrmwng::algorithm::interleave::lower_bound(vec, keys[i]); }, results.begin());
+        EXPECT_EQ(results, expected) << "in flight " << in_flight;
+    }
+}
+
+TEST(LowerBoundInterleaveTest, HeterogeneousLookups) {
+    struct CustomType {
+        int value;
+        bool operator<(const CustomType& other) const {
+            return value < other.value;
+        }
+    };
+
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    std::vector<float> vec_f = {1.1f, 2.2f, 4.4f, 5.5f, 6.6f};
+    std::vector<double> vec_d(1000);
+    for (size_t i = 0; i < vec_d.size(); ++i) {
+        vec_d[i] = static_cast<double>(i) * 0.5;
+    }
+    std::vector<CustomType> custom_vec = {{1}, {3}, {5}};
+
+    std::vector<size_t> results(5);
+    jrmwng::algorithm::interleave::run(4, results.size(), [&](size_t i) {
+        switch (i) {
+        case 0: return jrmwng::algorithm::interleave::lower_bound(vec, 3);
+        case 1: return jrmwng::algorithm::interleave::lower_bound(vec_f, 3.3f);
+        case 2: return jrmwng::algorithm::interleave::lower_bound(vec_d, 123.25);
+        case 3: return jrmwng::algorithm::interleave::lower_bound(custom_vec, CustomType{4});
+        default: return jrmwng::algorithm::interleave::lower_bound(vec_d, 3.0, std::less<double>(), [](double d) { return d; });
+        }
+    }, results.begin());
+    EXPECT_EQ(results, (std::vector<size_t>{2, 2, 247, 2, 6}));
+}
+
+TEST(LowerBoundInterleaveTest, ExplicitFanoutWithProjection) {
+    struct CustomIntType {
+        int value;
+    };
+
+    std::vector<CustomIntType> custom_vec_int = {{1}, {3}, {5}, {7}, {9}, {11}};
+    for (int value = 0; value < 13; ++value) {
+        auto task = jrmwng::algorithm::interleave::lower_bound<2>(custom_vec_int, value, [](auto const &tuple, int rhs) {
+            return (std::get<0>(tuple) < rhs ? 1 : 0) | (std::get<1>(tuple) < rhs ? 2 : 0);
+        }, [](auto const &... cts) { return std::make_tuple(cts.value...); });
+        while (!task.step()) {
+        }
+        EXPECT_EQ(task.result(), static_cast<size_t>(value / 2));
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <array>
+#include <span>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "lower_bound_kary.hpp"
+#include "lower_bound_test_utils.hpp"
+
+TEST(LowerBoundKaryTest, Basic) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    jrmwng::algorithm::simd::kary_schedule_t<8> const schedule(vec.size());
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(vec, 3, schedule), vec.begin() + 2);
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(vec, 0, schedule), vec.begin());
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(vec, 6, schedule), vec.begin() + 4);
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(vec, 7, schedule), vec.end());
+}
+
+TEST(LowerBoundKaryTest, Schedule) {
+    constexpr jrmwng::algorithm::simd::kary_schedule_t<8> schedule(100);
+    static_assert(schedule.levels() == 3 && schedule.padded_size() == 728);
+    static_assert(schedule.stride(0) == 81 && schedule.stride(1) == 9 && schedule.stride(2) == 1);
+    static_assert(jrmwng::algorithm::simd::kary_schedule_t<8>(0).levels() == 0);
+    static_assert(jrmwng::algorithm::simd::kary_schedule_t<8>(8).levels() == 1);
+    static_assert(jrmwng::algorithm::simd::kary_schedule_t<8>(9).levels() == 2);
+    static_assert(jrmwng::algorithm::simd::kary_schedule_t<1>(1023).levels() == 10);
+    static_assert(jrmwng::algorithm::simd::kary_fanout_v<float> == 8 && jrmwng::algorithm::simd::kary_fanout_v<double> == 4);
+    static_assert(jrmwng::algorithm::simd::kary_fanout_v<short> == 1);
+    EXPECT_THROW(jrmwng::algorithm::simd::kary_schedule_t<32>(SIZE_MAX), std::invalid_argument);
+
+    std::vector<int> vec(10);
+    EXPECT_THROW(jrmwng::algorithm::simd::kary_lower_bound(vec, 1, schedule), std::invalid_argument);
+}
+
+TEST(LowerBoundKaryTest, AllSizesAroundLevelBoundaries) {
+    for (size_t size = 0; size <= 800; ++size) {
+        std::vector<int> vec(size);
+        for (size_t i = 0; i < size; ++i) {
+            vec[i] = static_cast<int>(i * 2);
+        }
+        std::vector<int> queries;
+        for (int q = -1; q <= static_cast<int>(size * 2); ++q) {
+            queries.push_back(q);
+        }
+        jrmwng::algorithm::simd::kary_schedule_t<8> const schedule8(size);
+        jrmwng::algorithm::simd::kary_schedule_t<1> const schedule1(size);
+        jrmwng::algorithm::simd::kary_schedule_t<3> const schedule3(size);
+        SCOPED_TRACE(size);
+        ExpectMatchesStd(vec, queries, [&](int q) { return jrmwng::algorithm::simd::kary_lower_bound(vec, q, schedule8); });
+        ExpectMatchesStd(vec, queries, [&](int q) { return jrmwng::algorithm::simd::kary_lower_bound(vec, q, schedule1); });
+        ExpectMatchesStd(vec, queries, [&](int q) { return jrmwng::algorithm::simd::kary_lower_bound(vec, q, schedule3); });
+    }
+}
+
+TEST(LowerBoundKaryTest, RandomWithDuplicates) {
+    std::mt19937_64 rng(3);
+    for (size_t size : {1000u, 100000u}) {
+        std::vector<float> floats(size);
+        std::vector<double> doubles(size);
+        std::vector<uint64_t> uints(size);
+        std::vector<int64_t> ints(size);
+        for (size_t i = 0; i < size; ++i) {
+            floats[i] = static_cast<float>(rng() % 500);
+            doubles[i] = static_cast<double>(rng() % 500) / 7;
+            uints[i] = rng() % (size / 4) + (uint64_t(1) << 63);
+            ints[i] = static_cast<int64_t>(rng() % size) - static_cast<int64_t>(size / 2);
+        }
+        std::sort(floats.begin(), floats.end());
+        std::sort(doubles.begin(), doubles.end());
+        std::sort(uints.begin(), uints.end());
+        std::sort(ints.begin(), ints.end());
+        jrmwng::algorithm::simd::kary_schedule_t<8> const schedule8(size);
+        jrmwng::algorithm::simd::kary_schedule_t<4> const schedule4(size);
+        SCOPED_TRACE(size);
+        ExpectMatchesStd(floats, std::vector<float>(floats.begin(), floats.begin() + 500), [&](float q) { return jrmwng::algorithm::simd::kary_lower_bound(floats, q, schedule8); });
+        ExpectMatchesStd(doubles, std::vector<double>(doubles.begin(), doubles.begin() + 500), [&](double q) { return jrmwng::algorithm::simd::kary_lower_bound(doubles, q, schedule4); });
+        ExpectMatchesStd(uints, std::vector<uint64_t>(uints.begin(), uints.begin() + 500), [&](uint64_t q) { return jrmwng::algorithm::simd::kary_lower_bound(uints, q, schedule4); });
+        ExpectMatchesStd(ints, std::vector<int64_t>(ints.begin(), ints.begin() + 500), [&](int64_t q) { return jrmwng::algorithm::simd::kary_lower_bound(ints, q, schedule4); });
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(ints, INT64_MIN, schedule4), ints.begin());
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(ints, INT64_MAX, schedule4), ints.end());
+    }
+}
+
+TEST(LowerBoundKaryTest, ComparatorAndProjection) {
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(1000 - i);
+    }
+    jrmwng::algorithm::simd::kary_schedule_t<8> const schedule(vec.size());
+    for (int q : {0, 1, 500, 1000, 1001}) {
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(vec, q, schedule, std::greater<int>()),
+                  std::lower_bound(vec.begin(), vec.end(), q, std::greater<int>())) << q;
+    }
+
+    std::vector<std::pair<short, int>> pairs(300);
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        pairs[i] = {static_cast<short>(i / 3), static_cast<int>(i)};
+    }
+    jrmwng::algorithm::simd::kary_schedule_t<1> const scalar(pairs.size());
+    auto const it = jrmwng::algorithm::simd::kary_lower_bound(pairs, short(50), scalar, std::less<short>(), &std::pair<short, int>::first);
+    EXPECT_EQ(it - pairs.begin(), 150);
+}
+
+// A comparison with both a scalar and a SIMD form, counting the calls of each.
+struct CountingLess {
+    using Traits = jrmwng::algorithm::simd::details::simd_traits<int>;
+    size_t *scalar;
+    size_t *vector;
+    bool operator()(int lhs, int rhs) const {
+        ++*scalar;
+        return lhs < rhs;
+    }
+    int operator()(Traits::simd_type const &lhs, Traits::simd_type const &rhs) const {
+        ++*vector;
+        return Traits::cmp_lt(lhs, rhs);
+    }
+};
+
+TEST(LowerBoundKaryTest, ComparesEachLevelInOneSimdCompare) {
+    static_assert(jrmwng::algorithm::simd::details::is_kary_simd_v<int, int, std::identity, 8>);
+    static_assert(!jrmwng::algorithm::simd::details::is_kary_simd_v<int, int, std::identity, 3>);
+    static_assert(!jrmwng::algorithm::simd::details::is_kary_simd_v<int64_t, int, std::identity, 8>);
+    static_assert(jrmwng::algorithm::simd::details::is_kary_simd_v<double, double, std::identity, 4>);
+    static_assert(!jrmwng::algorithm::simd::details::is_kary_simd_v<uint64_t, uint64_t, std::identity, 4>);
+
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i * 2);
+    }
+    jrmwng::algorithm::simd::kary_schedule_t<8> const schedule(vec.size());
+    size_t scalar = 0;
+    size_t vector = 0;
+    for (int q : {-1, 0, 777, 1998, 5000}) {
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(vec, q, schedule, CountingLess{&scalar, &vector}),
+                  std::lower_bound(vec.begin(), vec.end(), q)) << q;
+    }
+    EXPECT_EQ(scalar, 0u);
+    EXPECT_EQ(vector, 5 * schedule.levels());
+
+    std::array<int, 64> node{};
+    for (size_t i = 0; i < node.size(); ++i) {
+        node[i] = static_cast<int>(i);
+    }
+    vector = 0;
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(node, 42, CountingLess{&scalar, &vector}), node.begin() + 42);
+    EXPECT_EQ(scalar, 0u);
+    EXPECT_EQ(vector, 2u);
+}
+
+TEST(LowerBoundKaryTest, FixedSizeUnrolled) {
+    std::array<int, 64> node{};
+    for (size_t i = 0; i < node.size(); ++i) {
+        node[i] = static_cast<int>(i * 3);
+    }
+    for (int q = -1; q < 200; ++q) {
+        auto const expected = std::lower_bound(node.begin(), node.end(), q);
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(node, q), expected) << q;
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound<2>(node, q), expected) << q;
+        std::span<int const, 64> const span(node);
+        EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(span, q) - span.begin(), expected - node.begin()) << q;
+    }
+
+    double leaf[5] = {0.5, 1.5, 1.5, 2.5, 9.0};
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(leaf, 1.5), leaf + 1);
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(leaf, 10.0), leaf + 5);
+    std::array<float, 0> empty{};
+    EXPECT_EQ(jrmwng::algorithm::simd::kary_lower_bound(empty, 1.0f), empty.end());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
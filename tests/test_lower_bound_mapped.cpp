@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include "lower_bound_mapped.hpp"
+#include "lower_bound_test_utils.hpp"
+
+static void FlipByte(std::filesystem::path const &path, long offset) {
+    std::FILE *file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, offset, SEEK_SET);
+    int const byte = std::fgetc(file);
+    std::fseek(file, offset, SEEK_SET);
+    std::fputc(byte ^ 0x40, file);
+    std::fclose(file);
+}
+
+TEST(LowerBoundMappedTest, Sorted) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_sorted.idx";
+    std::vector<int> keys(10000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(3 * i) - 5000;
+    }
+    jrmwng::algorithm::mapped::save<int>(path, keys);
+
+    jrmwng::algorithm::mapped::index_t<int> index(path);
+    EXPECT_EQ(index.kind(), jrmwng::algorithm::mapped::layout_kind::sorted);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(index.keys().data()) % 4096, 0u);
+    EXPECT_TRUE(index.verify());
+    EXPECT_TRUE(std::ranges::equal(index.keys(), keys));
+    std::vector<int> queries;
+    for (int query = -5001; query <= 25000; ++query) {
+        queries.push_back(query);
+    }
+    ExpectMatchesStd(keys, queries, [&](int query) { return index.lower_bound(query); });
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundMappedTest, Veb) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_veb.idx";
+    std::vector<uint64_t> keys(50000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = 2 * i + 1;
+    }
+    jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb(keys);
+    jrmwng::algorithm::mapped::save<uint64_t>(path, keys, veb);
+
+    jrmwng::algorithm::mapped::load_options options;
+    options.verify_checksums = true;
+    options.populate = true;
+    jrmwng::algorithm::mapped::index_t<uint64_t> loaded(path, options);
+    EXPECT_EQ(loaded.kind(), jrmwng::algorithm::mapped::layout_kind::veb);
+    EXPECT_EQ(loaded.veb().size(), keys.size());
+    EXPECT_TRUE(std::ranges::equal(loaded.veb().nodes(), veb.view().nodes()));
+
+    // Moving keeps the mapping and the views into it.
+    jrmwng::algorithm::mapped::index_t<uint64_t> index(std::move(loaded));
+    ASSERT_EQ(index.size(), keys.size());
+    std::vector<uint64_t> queries = {UINT64_MAX};
+    for (uint64_t query = 0; query <= 2 * keys.size() + 1; ++query) {
+        queries.push_back(query);
+    }
+    ExpectMatchesStd(keys, queries, [&](uint64_t query) { return index.lower_bound(query); });
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundMappedTest, Empty) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_empty.idx";
+    std::vector<float> keys;
+    jrmwng::algorithm::layout::veb_layout_t<float> veb(keys);
+    jrmwng::algorithm::mapped::save<float>(path, keys, veb);
+
+    jrmwng::algorithm::mapped::index_t<float> index(path);
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.lower_bound(1.0f), 0u);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundMappedTest, ReplacesFileUnderReader) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_replace.idx";
+    std::vector<int> before = {1, 2, 3};
+    std::vector<int> after = {10, 20, 30, 40};
+    jrmwng::algorithm::mapped::save<int>(path, before);
+    jrmwng::algorithm::mapped::index_t<int> old_index(path);
+
+    jrmwng::algorithm::mapped::save<int>(path, after);
+    jrmwng::algorithm::mapped::index_t<int> new_index(path);
+    EXPECT_TRUE(std::ranges::equal(old_index.keys(), before));
+    EXPECT_EQ(old_index.lower_bound(2), 1u);
+    EXPECT_EQ(old_index.lower_bound(4), 3u);
+    EXPECT_TRUE(std::ranges::equal(new_index.keys(), after));
+    EXPECT_EQ(new_index.lower_bound(2), 0u);
+    EXPECT_EQ(new_index.lower_bound(35), 3u);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundMappedTest, FailedSaveLeavesNoTemporaryFile) {
+    // A non-empty directory in the way makes the rename fail after the temporary file is written.
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_blocked.idx";
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::filesystem::create_directories(path / "child");
+    std::vector<int> keys = {1, 2, 3};
+    EXPECT_THROW(jrmwng::algorithm::mapped::save<int>(path, keys), std::system_error);
+    EXPECT_FALSE(std::filesystem::exists(temp));
+    std::filesystem::remove_all(path);
+
+    EXPECT_THROW(jrmwng::algorithm::mapped::save<int>(path / "missing" / "keys.idx", keys), std::system_error);
+}
+
+TEST(LowerBoundMappedTest, DetectsCorruption) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_corrupt.idx";
+    std::vector<int> keys(1000);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(i);
+    }
+    jrmwng::algorithm::mapped::save<int>(path, keys);
+
+    // A damaged key loads without verification, but verify() and a verifying load catch it.
+    FlipByte(path, 4096 + 100);
+    {
+        jrmwng::algorithm::mapped::index_t<int> index(path);
+        EXPECT_FALSE(index.verify());
+    }
+    jrmwng::algorithm::mapped::load_options options;
+    options.verify_checksums = true;
+    EXPECT_THROW((jrmwng::algorithm::mapped::index_t<int>{path, options}), std::runtime_error);
+
+    // A damaged header never loads.
+    FlipByte(path, 4096 + 100);
+    FlipByte(path, 40);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<int>{path}, std::runtime_error);
+    FlipByte(path, 40);
+    EXPECT_NO_THROW(jrmwng::algorithm::mapped::index_t<int>{path});
+
+    std::filesystem::resize_file(path, 4096 + 2000);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<int>{path}, std::runtime_error);
+    std::filesystem::resize_file(path, 16);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<int>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundMappedTest, RejectsMismatchedTypes) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_mapped_mismatch.idx";
+    std::vector<int> keys = {1, 2, 3};
+    jrmwng::algorithm::mapped::save<int>(path, keys);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<float>{path}, std::runtime_error);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<uint32_t>{path}, std::runtime_error);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<int64_t>{path}, std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(jrmwng::algorithm::mapped::index_t<int>{path}, std::system_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "lower_bound_normalize.hpp"
+
+template <typename T>
+static void ExpectOrderPreserved(std::vector<T> const &sorted) {
+    for (size_t i = 0; i + 1 < sorted.size(); ++i) {
+        EXPECT_LT(jrmwng::algorithm::keys::normalize(sorted[i]), jrmwng::algorithm::keys::normalize(sorted[i + 1])) << sorted[i] << " vs " << sorted[i + 1];
+    }
+    for (T value : sorted) {
+        EXPECT_EQ(jrmwng::algorithm::keys::denormalize<T>(jrmwng::algorithm::keys::normalize(value)), value);
+    }
+}
+
+TEST(LowerBoundNormalizeTest, SignedIntegers) {
+    ExpectOrderPreserved<int32_t>({std::numeric_limits<int32_t>::min(), -100, -1, 0, 1, 100, std::numeric_limits<int32_t>::max()});
+    ExpectOrderPreserved<int64_t>({std::numeric_limits<int64_t>::min(), -(int64_t(1) << 40), -1, 0, 1, int64_t(1) << 40, std::numeric_limits<int64_t>::max()});
+}
+
+TEST(LowerBoundNormalizeTest, Floats) {
+    float const inf = std::numeric_limits<float>::infinity();
+    ExpectOrderPreserved<float>({-inf, -std::numeric_limits<float>::max(), -1.5f, -std::numeric_limits<float>::denorm_min(), 0.0f,
+                                 std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(), 1.5f, std::numeric_limits<float>::max(), inf});
+}
+
+TEST(LowerBoundNormalizeTest, Doubles) {
+    double const inf = std::numeric_limits<double>::infinity();
+    ExpectOrderPreserved<double>({-inf, -1e300, -1.0, -1e-300, 0.0, 1e-300, 1.0, 1e300, inf});
+}
+
+TEST(LowerBoundNormalizeTest, SignedZerosAndNaNs) {
+    EXPECT_EQ(jrmwng::algorithm::keys::normalize(-0.0f), jrmwng::algorithm::keys::normalize(0.0f));
+    EXPECT_EQ(jrmwng::algorithm::keys::normalize(-0.0), jrmwng::algorithm::keys::normalize(0.0));
+
+    float const nan = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_EQ(jrmwng::algorithm::keys::normalize(nan), jrmwng::algorithm::keys::normalize(-nan));
+    EXPECT_GT(jrmwng::algorithm::keys::normalize(nan), jrmwng::algorithm::keys::normalize(std::numeric_limits<float>::infinity()));
+    EXPECT_TRUE(std::isnan(jrmwng::algorithm::keys::denormalize<float>(jrmwng::algorithm::keys::normalize(-nan))));
+    EXPECT_GT(jrmwng::algorithm::keys::normalize(std::numeric_limits<double>::signaling_NaN()), jrmwng::algorithm::keys::normalize(std::numeric_limits<double>::infinity()));
+
+    EXPECT_TRUE(jrmwng::algorithm::keys::total_less()(1.0, nan * 1.0));
+    EXPECT_FALSE(jrmwng::algorithm::keys::total_less()(nan, -nan));
+}
+
+TEST(LowerBoundNormalizeTest, ArrayMatchesStdOnNaNFreeData) {
+    std::vector<double> vec_d = {-5.5, -2.2, -0.0, 0.0, 1.1, 2.2, 4.4, 5.5, 6.6, 6.6, 6.6, 100.0};
+    jrmwng::algorithm::keys::normalized_array_t<double> keys(vec_d);
+    ASSERT_EQ(keys.size(), vec_d.size());
+    for (double value : {-10.0, -5.5, -1.0, -0.0, 0.0, 3.3, 6.6, 99.0, 1000.0}) {
+        EXPECT_EQ(keys.lower_bound(value), static_cast<size_t>(std::ranges::lower_bound(vec_d, value) - vec_d.begin())) << value;
+        EXPECT_EQ(keys.upper_bound(value), static_cast<size_t>(std::ranges::upper_bound(vec_d, value) - vec_d.begin())) << value;
+    }
+}
+
+TEST(LowerBoundNormalizeTest, ArrayWithNaNs) {
+    float const nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> column = {nan, 2.5f, -1.0f, -nan, -0.0f, std::numeric_limits<float>::infinity()};
+    jrmwng::algorithm::keys::normalized_array_t<float> keys(column);
+    EXPECT_EQ(keys[0], -1.0f);
+    EXPECT_EQ(keys[1], 0.0f);
+    EXPECT_EQ(keys[2], 2.5f);
+    EXPECT_EQ(keys[3], std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isnan(keys[4]));
+    EXPECT_TRUE(std::isnan(keys[5]));
+
+    EXPECT_EQ(keys.lower_bound(0.0f), 1u);
+    EXPECT_EQ(keys.lower_bound(-0.0f), 1u);
+    EXPECT_EQ(keys.lower_bound(1e30f), 3u);
+    EXPECT_EQ(keys.lower_bound(nan), 4u);
+    EXPECT_EQ(keys.upper_bound(nan), 6u);
+    EXPECT_EQ(keys.upper_bound(std::numeric_limits<float>::infinity()), 4u);
+}
+
+TEST(LowerBoundNormalizeTest, ArraySignedIntegers) {
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i) * 3 - 1500;
+    }
+    jrmwng::algorithm::keys::normalized_array_t<int> keys(vec);
+    for (int value = -1600; value < 1600; value += 7) {
+        EXPECT_EQ(keys.lower_bound(value), static_cast<size_t>(std::ranges::lower_bound(vec, value) - vec.begin())) << value;
+    }
+}
+
+TEST(LowerBoundNormalizeTest, EmptyVector) {
+    std::vector<int64_t> empty_vec;
+    jrmwng::algorithm::keys::normalized_array_t<int64_t> keys(empty_vec);
+    EXPECT_EQ(keys.lower_bound(1), 0u);
+    EXPECT_EQ(keys.upper_bound(1), 0u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
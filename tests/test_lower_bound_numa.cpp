@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include "lower_bound_numa.hpp"
+#include "lower_bound_veb.hpp"
+
+TEST(LowerBoundNumaTest, ParseList) {
+    EXPECT_EQ(jrmwng::algorithm::numa::details::parse_list("0"), (std::vector<size_t>{0}));
+    EXPECT_EQ(jrmwng::algorithm::numa::details::parse_list("0-3,8,10-11\n"), (std::vector<size_t>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_TRUE(jrmwng::algorithm::numa::details::parse_list("").empty());
+}
+
+TEST(LowerBoundNumaTest, Topology) {
+    EXPECT_GE(jrmwng::algorithm::numa::node_count(), 1u);
+    EXPECT_LT(jrmwng::algorithm::numa::current_node(), jrmwng::algorithm::numa::node_count());
+}
+
+TEST(LowerBoundNumaTest, OneReplicaPerNode) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    jrmwng::algorithm::numa::replicated_t<int> replicated(vec);
+    EXPECT_EQ(replicated.replicas(), jrmwng::algorithm::numa::node_count());
+    EXPECT_EQ(replicated.size(), vec.size());
+    for (size_t node = 0; node < replicated.replicas(); ++node) {
+        auto replica = replicated.replica(node);
+        EXPECT_TRUE(std::ranges::equal(replica, vec));
+        EXPECT_NE(replica.data(), vec.data());
+    }
+    // Replicas are bound at any size; a multi-node host binds at least the replica of the node this thread runs on.
+    EXPECT_EQ(replicated.bound(jrmwng::algorithm::numa::current_node()), jrmwng::algorithm::numa::node_count() > 1);
+}
+
+TEST(LowerBoundNumaTest, Integers) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    jrmwng::algorithm::numa::replicated_t<int> replicated(vec);
+    std::vector<int> test_values = {3, 0, 7};
+    std::vector<size_t> expected_indices = {2, 0, 5};
+    for (size_t i = 0; i < test_values.size(); ++i) {
+        EXPECT_EQ(replicated.lower_bound(test_values[i]), expected_indices[i]);
+    }
+}
+
+TEST(LowerBoundNumaTest, Doubles) {
+    std::vector<double> vec_d = {1.1, 2.2, 4.4, 5.5, 6.6};
+    jrmwng::algorithm::numa::replicated_t<double> replicated(vec_d);
+    EXPECT_EQ(replicated.lower_bound(3.3), 2u);
+    EXPECT_EQ(replicated.lower_bound(3.3, std::less<double>(), [](double d) { return d; }), 2u);
+}
+
+TEST(LowerBoundNumaTest, VebLayout) {
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i * 3);
+    }
+    jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+    jrmwng::algorithm::numa::replicated_t<int, jrmwng::algorithm::layout::veb_view_t<int>> replicated(veb.view());
+    EXPECT_EQ(replicated.size(), vec.size());
+    for (size_t node = 0; node < replicated.replicas(); ++node) {
+        EXPECT_TRUE(std::ranges::equal(replicated.replica(node), veb.view().nodes()));
+    }
+    EXPECT_EQ(replicated.lower_bound(0), 0u);
+    EXPECT_EQ(replicated.lower_bound(301), 101u);
+    EXPECT_EQ(replicated.lower_bound(2997), 999u);
+    EXPECT_EQ(replicated.lower_bound(3000), 1000u);
+}
+
+TEST(LowerBoundNumaTest, EmptyVector) {
+    std::vector<int> empty_vec;
+    jrmwng::algorithm::numa::replicated_t<int> replicated(empty_vec);
+    EXPECT_EQ(replicated.lower_bound(1), 0u);
+    EXPECT_TRUE(replicated.local().empty());
+}
+
+TEST(LowerBoundNumaTest, LargeArrayFromManyThreads) {
+    std::vector<int> vec(size_t(1) << 20);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i * 2);
+    }
+    jrmwng::algorithm::numa::replicated_t<int> replicated(vec);
+    // A multi-node host binds at least the replica of the node this thread runs on, which is online.
+    EXPECT_EQ(replicated.bound(jrmwng::algorithm::numa::current_node()), jrmwng::algorithm::numa::node_count() > 1);
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (size_t t = 0; t < mismatches.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int value = static_cast<int>(t); value < 1 << 21; value += 997) {
+                size_t expected = static_cast<size_t>(std::ranges::lower_bound(vec, value) - vec.begin());
+                mismatches[t] += replicated.lower_bound(value) != expected;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(std::count(mismatches.begin(), mismatches.end(), 0), static_cast<long>(mismatches.size()));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
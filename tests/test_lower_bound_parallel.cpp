@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "lower_bound_parallel.hpp"
+
+TEST(LowerBoundParallelTest, RunsEveryWorker) {
+    std::vector<int> ran(8, 0);
+    jrmwng::algorithm::parallel::parallel_for(ran.size(), [&](size_t t) { ran[t] += 1; });
+    EXPECT_EQ(ran, std::vector<int>(8, 1));
+
+    bool called = false;
+    jrmwng::algorithm::parallel::parallel_for(0, [&](size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(LowerBoundParallelTest, RethrowsAfterJoiningEveryWorker) {
+    std::atomic<int> finished{0};
+    auto const work = [&](size_t t) {
+        if (t == 2) {
+            throw std::runtime_error("worker 2");
+        }
+        // The other workers outlive the one that threw; all of them must have finished before the exception surfaces.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ++finished;
+    };
+    try {
+        jrmwng::algorithm::parallel::parallel_for(4, work);
+        ADD_FAILURE() << "no exception";
+    } catch (std::runtime_error const &error) {
+        EXPECT_STREQ(error.what(), "worker 2");
+    }
+    EXPECT_EQ(finished.load(), 3);
+
+    // An exception on the calling thread is reported the same way.
+    EXPECT_THROW(jrmwng::algorithm::parallel::parallel_for(3, [](size_t t) {
+        if (t == 0) {
+            throw std::invalid_argument("worker 0");
+        }
+    }), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
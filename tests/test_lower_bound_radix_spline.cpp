@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include "lower_bound_radix_spline.hpp"
+#include "lower_bound_test_utils.hpp"
+
+template <typename T>
+static std::vector<T> QueriesAround(std::vector<T> const &vec) {
+    std::vector<T> queries = {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()};
+    for (T const &key : vec) {
+        queries.push_back(key);
+        queries.push_back(static_cast<T>(key + 1));
+        queries.push_back(static_cast<T>(key - 1));
+    }
+    return queries;
+}
+
+TEST(LowerBoundRadixSplineTest, Basic) {
+    std::vector<uint32_t> vec = {3, 10, 11, 200, 4000, 4001};
+    jrmwng::algorithm::layout::radix_spline_t<uint32_t> index(vec, 4);
+    EXPECT_EQ(index.radix_bits(), 4u);
+    EXPECT_EQ(index.knots(), 0u);
+    EXPECT_EQ(index.lower_bound(0), 0u);
+    EXPECT_EQ(index.lower_bound(11), 2u);
+    EXPECT_EQ(index.lower_bound(12), 3u);
+    EXPECT_EQ(index.lower_bound(4001), 5u);
+    EXPECT_EQ(index.lower_bound(5000), 6u);
+}
+
+TEST(LowerBoundRadixSplineTest, HashedIds) {
+    std::mt19937_64 rng(11);
+    std::vector<uint64_t> vec(20000);
+    for (uint64_t &key : vec) {
+        key = rng();
+    }
+    std::sort(vec.begin(), vec.end());
+    std::vector<uint64_t> queries = QueriesAround(vec);
+    for (size_t i = 0; i < 2000; ++i) {
+        queries.push_back(rng());
+    }
+    for (size_t radix_bits : {0, 1, 8, 14, 20}) {
+        jrmwng::algorithm::layout::radix_spline_t<uint64_t> index(vec, radix_bits, 0);
+        SCOPED_TRACE(testing::Message() << "r=" << radix_bits);
+        ExpectMatchesStd(vec, queries, [&](uint64_t query) { return index.lower_bound(query); });
+    }
+    for (size_t spline_error : {1, 8, 64}) {
+        jrmwng::algorithm::layout::radix_spline_t<uint64_t> index(vec, 10, spline_error);
+        SCOPED_TRACE(testing::Message() << "E=" << spline_error);
+        ExpectMatchesStd(vec, queries, [&](uint64_t query) { return index.lower_bound(query); });
+    }
+}
+
+TEST(LowerBoundRadixSplineTest, SkewedSpline) {
+    std::vector<uint64_t> vec(20000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<uint64_t>(std::pow(static_cast<double>(i), 3.0));
+    }
+    jrmwng::algorithm::layout::radix_spline_t<uint64_t> spline(vec, 12, 16);
+    EXPECT_GT(spline.knots(), 2u);
+    EXPECT_LT(spline.knots(), vec.size() / 16);
+    ExpectMatchesStd(vec, QueriesAround(vec), [&](uint64_t query) { return spline.lower_bound(query); });
+
+    // Every key's lower bound lies in the window the spline predicts.
+    for (uint64_t const &key : vec) {
+        auto const [first, last] = spline.window(key);
+        size_t const expected = static_cast<size_t>(std::lower_bound(vec.begin(), vec.end(), key) - vec.begin());
+        EXPECT_LE(first, expected);
+        EXPECT_LE(expected, last);
+        EXPECT_LE(last - first, 2u * 16 + 2);
+    }
+}
+
+TEST(LowerBoundRadixSplineTest, Duplicates) {
+    std::vector<int32_t> vec;
+    for (int32_t key : {-7, 0, 5, 1000}) {
+        vec.insert(vec.end(), 500, key);
+    }
+    vec.push_back(1001);
+    for (size_t spline_error : {0, 2, 32}) {
+        jrmwng::algorithm::layout::radix_spline_t<int32_t> index(vec, 6, spline_error);
+        SCOPED_TRACE(testing::Message() << "E=" << spline_error);
+        ExpectMatchesStd(vec, QueriesAround(vec), [&](int32_t query) { return index.lower_bound(query); });
+    }
+}
+
+TEST(LowerBoundRadixSplineTest, SignedAndFloat) {
+    std::vector<int64_t> vec;
+    for (int64_t i = -5000; i < 5000; i += 3) {
+        vec.push_back(i * i * (i < 0 ? -1 : 1));
+    }
+    jrmwng::algorithm::layout::radix_spline_t<int64_t> exact(vec, 10, 0);
+    jrmwng::algorithm::layout::radix_spline_t<int64_t> spline(vec, 10, 4);
+    ExpectMatchesStd(vec, QueriesAround(vec), [&](int64_t query) { return exact.lower_bound(query); });
+    ExpectMatchesStd(vec, QueriesAround(vec), [&](int64_t query) { return spline.lower_bound(query); });
+
+    std::vector<float> floats = {-2.5f, -1.0f, 0.0f, 0.25f, 3.0f, 1e9f};
+    jrmwng::algorithm::layout::radix_spline_t<float> exact_f(floats, 4, 0);
+    jrmwng::algorithm::layout::radix_spline_t<float> spline_f(floats, 4, 1);
+    EXPECT_EQ(exact_f.lower_bound(-3.0f), 0u);
+    EXPECT_EQ(exact_f.lower_bound(-0.5f), 2u);
+    EXPECT_EQ(exact_f.lower_bound(0.1f), 3u);
+    EXPECT_EQ(exact_f.lower_bound(1e10f), 6u);
+    EXPECT_EQ(spline_f.lower_bound(-2.5f), 0u);
+    EXPECT_EQ(spline_f.lower_bound(0.0f), 2u);
+    EXPECT_EQ(spline_f.lower_bound(2.0f), 4u);
+    EXPECT_EQ(spline_f.lower_bound(1e10f), 6u);
+}
+
+TEST(LowerBoundRadixSplineTest, PositionType) {
+    std::vector<uint64_t> vec(4096);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = i * i;
+    }
+    jrmwng::algorithm::layout::radix_spline_t<uint64_t> narrow(vec, 10);
+    jrmwng::algorithm::layout::radix_spline_t<uint64_t, size_t> wide(vec, 10);
+    EXPECT_EQ(narrow.bytes() * 2, wide.bytes());
+    ExpectMatchesStd(vec, QueriesAround(vec), [&](uint64_t query) { return narrow.lower_bound(query); });
+    ExpectMatchesStd(vec, QueriesAround(vec), [&](uint64_t query) { return wide.lower_bound(query); });
+
+    jrmwng::algorithm::layout::radix_spline_t<uint64_t, uint16_t> spline(std::span<uint64_t const>(vec).first(1000), 6, 4);
+    EXPECT_EQ(spline.lower_bound(vec[999]), 999u);
+    EXPECT_THROW((jrmwng::algorithm::layout::radix_spline_t<uint64_t, uint8_t>(vec)), std::length_error);
+}
+
+TEST(LowerBoundRadixSplineTest, EmptyAndSingle) {
+    std::vector<uint32_t> empty;
+    jrmwng::algorithm::layout::radix_spline_t<uint32_t> index(empty);
+    EXPECT_EQ(index.lower_bound(5), 0u);
+
+    std::vector<uint32_t> single = {7};
+    for (size_t spline_error : {0, 4}) {
+        jrmwng::algorithm::layout::radix_spline_t<uint32_t> index_single(single, 0, spline_error);
+        EXPECT_EQ(index_single.lower_bound(0), 0u);
+        EXPECT_EQ(index_single.lower_bound(7), 0u);
+        EXPECT_EQ(index_single.lower_bound(8), 1u);
+        EXPECT_EQ(index_single.lower_bound(UINT32_MAX), 1u);
+    }
+
+    std::vector<uint64_t> extremes = {0, 1, UINT64_MAX - 1, UINT64_MAX};
+    for (size_t spline_error : {0, 1}) {
+        jrmwng::algorithm::layout::radix_spline_t<uint64_t> index_extremes(extremes, 8, spline_error);
+        EXPECT_EQ(index_extremes.lower_bound(0), 0u);
+        EXPECT_EQ(index_extremes.lower_bound(2), 2u);
+        EXPECT_EQ(index_extremes.lower_bound(UINT64_MAX - 1), 2u);
+        EXPECT_EQ(index_extremes.lower_bound(UINT64_MAX), 3u);
+    }
+    EXPECT_THROW((jrmwng::algorithm::layout::radix_spline_t<uint32_t>(single, 31)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "lower_bound_run_length.hpp"
+#include "lower_bound_test_utils.hpp"
+
+TEST(LowerBoundRunLengthTest, Basic) {
+    std::vector<int> column = {3, 3, 3, 5, 5, 9};
+    jrmwng::algorithm::layout::run_length_t runs(column);
+    EXPECT_EQ(runs.keys(), (std::vector<int>{3, 5, 9}));
+    EXPECT_EQ(runs.offsets(), (std::vector<size_t>{0, 3, 5, 6}));
+    EXPECT_EQ(runs.lower_bound(5), 3u);
+    EXPECT_EQ(runs.upper_bound(5), 5u);
+    EXPECT_EQ(runs.equal_range(4), (std::pair<size_t, size_t>{3, 3}));
+    EXPECT_EQ(runs.equal_range(10), (std::pair<size_t, size_t>{6, 6}));
+}
+
+TEST(LowerBoundRunLengthTest, Empty) {
+    std::vector<int> column;
+    jrmwng::algorithm::layout::run_length_t runs(column);
+    EXPECT_EQ(runs.size(), 0u);
+    EXPECT_EQ(runs.equal_range(1), (std::pair<size_t, size_t>{0, 0}));
+}
+
+TEST(LowerBoundRunLengthTest, RandomRuns) {
+    std::mt19937 rng(21);
+    for (int distinct : {1, 7, 50, 1000}) {
+        std::vector<int> vec(20000);
+        for (auto &x : vec) {
+            x = static_cast<int>(rng() % distinct) * 3;
+        }
+        std::ranges::sort(vec);
+        std::vector<int> queries;
+        for (int q = -2; q < distinct * 3 + 2; ++q) {
+            queries.push_back(q);
+        }
+        jrmwng::algorithm::layout::run_length_t<int> runs(vec);
+        ASSERT_EQ(runs.size(), vec.size());
+        SCOPED_TRACE(distinct);
+        ExpectMatchesStd(vec, queries, [&](int q) { return runs.lower_bound(q); });
+        ExpectMatchesStd(vec, queries, [&](int q) { return runs.equal_range(q).first; });
+        // The upper bound is the lower bound under "not after": the first key the query compares before.
+        ExpectMatchesStd(vec, queries, [&](int q) { return runs.upper_bound(q); }, std::less_equal<int>());
+        ExpectMatchesStd(vec, queries, [&](int q) { return runs.equal_range(q).second; }, std::less_equal<int>());
+    }
+}
+
+TEST(LowerBoundRunLengthTest, OtherTypesAndComparators) {
+    std::vector<double> doubles = {0.5, 0.5, 1.5, 2.5, 2.5, 2.5};
+    jrmwng::algorithm::layout::run_length_t runs_d(doubles);
+    EXPECT_EQ(runs_d.lower_bound(0.0), 0u);
+    EXPECT_EQ(runs_d.lower_bound(1.0), 2u);
+    EXPECT_EQ(runs_d.equal_range(2.5), (std::pair<size_t, size_t>{3, 6}));
+    EXPECT_EQ(runs_d.upper_bound(3.0), 6u);
+
+    std::vector<uint64_t> u64s = {1, 1, 1, UINT64_MAX, UINT64_MAX};
+    jrmwng::algorithm::layout::run_length_t runs_u64(u64s);
+    EXPECT_EQ(runs_u64.lower_bound(0), 0u);
+    EXPECT_EQ(runs_u64.equal_range(1), (std::pair<size_t, size_t>{0, 3}));
+    EXPECT_EQ(runs_u64.lower_bound(2), 3u);
+    EXPECT_EQ(runs_u64.equal_range(UINT64_MAX), (std::pair<size_t, size_t>{3, 5}));
+
+    std::vector<int> descending = {9, 9, 7, 4, 4, 4, 1};
+    jrmwng::algorithm::layout::run_length_t runs_desc(descending);
+    EXPECT_EQ(runs_desc.lower_bound(10, std::greater<int>()), 0u);
+    EXPECT_EQ(runs_desc.equal_range(9, std::greater<int>()), (std::pair<size_t, size_t>{0, 2}));
+    EXPECT_EQ(runs_desc.lower_bound(8, std::greater<int>()), 2u);
+    EXPECT_EQ(runs_desc.equal_range(4, std::greater<int>()), (std::pair<size_t, size_t>{3, 6}));
+    EXPECT_EQ(runs_desc.upper_bound(2, std::greater<int>()), 6u);
+    EXPECT_EQ(runs_desc.lower_bound(0, std::greater<int>()), 7u);
+}
+
+TEST(LowerBoundRunLengthTest, MemorySavings) {
+    std::vector<int> column(100000);
+    for (size_t i = 0; i < column.size(); ++i) {
+        column[i] = static_cast<int>(i / 1000);
+    }
+    jrmwng::algorithm::layout::run_length_t runs(column);
+    EXPECT_EQ(runs.keys().size(), 100u);
+    EXPECT_EQ(runs.dense_bytes(), column.size() * sizeof(int));
+    EXPECT_EQ(runs.bytes(), 100 * sizeof(int) + 101 * sizeof(size_t));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
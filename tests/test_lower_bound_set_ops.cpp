@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstdint>
+#include "lower_bound_set_ops.hpp"
+
+template <typename T>
+static std::vector<T> RandomSet(size_t size, uint32_t universe, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<T> set;
+    for (size_t i = 0; i < size; ++i) {
+        set.push_back(static_cast<T>(rng() % universe));
+    }
+    std::ranges::sort(set);
+    set.erase(std::unique(set.begin(), set.end()), set.end());
+    return set;
+}
+
+TEST(LowerBoundSetOpsTest, Basic) {
+    std::vector<uint32_t> a = {1, 3, 5, 7};
+    std::vector<uint32_t> b = {3, 4, 5};
+    std::vector<uint32_t> out(4);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(a, b, out), 2u);
+    EXPECT_EQ(out[0], 3u);
+    EXPECT_EQ(out[1], 5u);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(a, b, out), 2u);
+    EXPECT_EQ(out[0], 1u);
+    EXPECT_EQ(out[1], 7u);
+}
+
+TEST(LowerBoundSetOpsTest, OtherTypes) {
+    std::vector<int> a = {-5, -1, 0, 4, 9, 12, 30, 31, 32, 33};
+    std::vector<int> b = {-1, 1, 4, 12, 32, 40};
+    std::vector<int> out(10);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(a, b, out), 4u);
+    EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + 4), (std::vector<int>{-1, 4, 12, 32}));
+    EXPECT_EQ(jrmwng::algorithm::sets::count_intersection(a, b), 4u);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(a, b, out), 6u);
+    EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + 6), (std::vector<int>{-5, 0, 9, 30, 31, 33}));
+
+    std::vector<int64_t> a64 = {INT64_MIN, -7, 3, 100, INT64_MAX};
+    std::vector<int64_t> b64 = {-7, 100, 101, INT64_MAX};
+    std::vector<int64_t> out64(5);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(a64, b64, out64), 3u);
+    EXPECT_EQ(std::vector<int64_t>(out64.begin(), out64.begin() + 3), (std::vector<int64_t>{-7, 100, INT64_MAX}));
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(a64, b64, out64), 2u);
+    EXPECT_EQ(std::vector<int64_t>(out64.begin(), out64.begin() + 2), (std::vector<int64_t>{INT64_MIN, 3}));
+
+    std::vector<double> ad = {0.5, 1.5, 2.5, 3.5};
+    std::vector<double> bd = {1.5, 3.0, 3.5};
+    std::vector<double> outd(4);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(ad, bd, outd), 2u);
+    EXPECT_EQ(std::vector<double>(outd.begin(), outd.begin() + 2), (std::vector<double>{1.5, 3.5}));
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(ad, bd, outd), 2u);
+    EXPECT_EQ(std::vector<double>(outd.begin(), outd.begin() + 2), (std::vector<double>{0.5, 2.5}));
+}
+
+TEST(LowerBoundSetOpsTest, RandomSets) {
+    for (uint32_t seed = 0; seed < 20; ++seed) {
+        auto const large = RandomSet<uint32_t>(20000, 100000, seed);
+        auto const similar = RandomSet<uint32_t>(15000 + seed * 37, 100000, seed + 100);
+        auto const small = RandomSet<uint32_t>(1 + seed * 7, 100000, seed + 200);
+        // Guarantee matches by sampling a small set from the large one.
+        std::vector<uint32_t> sampled;
+        for (size_t i = seed; i < large.size(); i += 997) {
+            sampled.push_back(large[i]);
+        }
+        for (auto const *other : {&similar, &small, &std::as_const(sampled)}) {
+            for (auto const &[a, b] : {std::pair(&large, other), std::pair(other, &large)}) {
+                std::vector<uint32_t> expected_intersection;
+                std::ranges::set_intersection(*a, *b, std::back_inserter(expected_intersection));
+                std::vector<uint32_t> expected_difference;
+                std::ranges::set_difference(*a, *b, std::back_inserter(expected_difference));
+                SCOPED_TRACE(testing::Message() << a->size() << " x " << b->size());
+
+                std::vector<uint32_t> out(a->size());
+                size_t const intersection_size = jrmwng::algorithm::sets::intersect(*a, *b, out);
+                EXPECT_EQ(std::vector<uint32_t>(out.begin(), out.begin() + intersection_size), expected_intersection);
+                EXPECT_EQ(jrmwng::algorithm::sets::count_intersection(*a, *b), expected_intersection.size());
+                size_t const difference_size = jrmwng::algorithm::sets::difference(*a, *b, out);
+                EXPECT_EQ(std::vector<uint32_t>(out.begin(), out.begin() + difference_size), expected_difference);
+            }
+        }
+    }
+}
+
+TEST(LowerBoundSetOpsTest, EdgeCases) {
+    std::vector<int> empty;
+    std::vector<int> some = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17};
+    std::vector<int> disjoint = {100, 200, 300, 400, 500, 600, 700, 800, 900};
+    std::vector<int> out(some.size());
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(empty, some, out), 0u);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(empty, some, out), 0u);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(some, empty, out), 0u);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(some, empty, out), some.size());
+    EXPECT_EQ(out, some);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(empty, empty, out), 0u);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(some, some, out), some.size());
+    EXPECT_EQ(out, some);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(some, some, out), 0u);
+    EXPECT_EQ(jrmwng::algorithm::sets::count_intersection(some, disjoint), 0u);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(some, disjoint, out), some.size());
+    EXPECT_EQ(out, some);
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(disjoint, some, out), disjoint.size());
+    EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + 9), disjoint);
+}
+
+TEST(LowerBoundSetOpsTest, ScalarType) {
+    std::vector<short> a = {1, 2, 3, 5, 8, 13};
+    std::vector<short> b = {2, 3, 4, 13};
+    std::vector<short> out(6);
+    EXPECT_EQ(jrmwng::algorithm::sets::intersect(a, b, out), 3u);
+    EXPECT_EQ(std::vector<short>(out.begin(), out.begin() + 3), (std::vector<short>{2, 3, 13}));
+    EXPECT_EQ(jrmwng::algorithm::sets::difference(a, b, out), 3u);
+    EXPECT_EQ(std::vector<short>(out.begin(), out.begin() + 3), (std::vector<short>{1, 5, 8}));
+}
+
+TEST(LowerBoundSetOpsTest, OutputTooShort) {
+    std::vector<int> a = {1, 2, 3};
+    std::vector<int> b = {2, 3};
+    std::vector<int> out(1);
+    EXPECT_THROW(jrmwng::algorithm::sets::intersect(a, b, out), std::invalid_argument);
+    EXPECT_THROW(jrmwng::algorithm::sets::difference(a, b, out), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
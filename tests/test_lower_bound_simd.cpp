@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <cstdint>
 #include "lower_bound_simd.hpp"
 
 struct SquareProjection
@@ -329,6 +333,109 @@ TEST(LowerBoundSimdTest, SquareProjectionMixedIntegers) {
     }
 }
 
+TEST(LowerBoundSimdTest, UnsignedIntegers) {
+    std::vector<uint32_t> vec = {1, 2, 4, 5, 6, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFEu};
+    std::vector<uint32_t> test_values = {0, 3, 7, 0x7FFFFFFFu, 0x80000000u, 0x80000001u, 0xFFFFFFFFu};
+    for (uint32_t value : test_values) {
+        auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, value);
+        EXPECT_EQ(it_simd, std::lower_bound(vec.begin(), vec.end(), value));
+    }
+}
+
+TEST(LowerBoundSimdTest, Unsigned64Integers) {
+    std::vector<uint64_t> vec = {1, 2, 4, 5, 6, 0x7FFFFFFFFFFFFFFFull, 0x8000000000000000ull, 0xFFFFFFFFFFFFFFFEull};
+    std::vector<uint64_t> test_values = {0, 3, 7, 0x7FFFFFFFFFFFFFFFull, 0x8000000000000000ull, 0x8000000000000001ull, 0xFFFFFFFFFFFFFFFFull};
+    for (uint64_t value : test_values) {
+        auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, value);
+        EXPECT_EQ(it_simd, std::lower_bound(vec.begin(), vec.end(), value));
+    }
+}
+
+TEST(LowerBoundSimdTest, UnsignedGreaterEqual) {
+    std::vector<uint32_t> vec = {0xFFFFFFF0u, 0x90000000u, 0x10u, 0x1u};
+    auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, 0x10u, std::greater<uint32_t>());
+    EXPECT_EQ(it_simd, vec.begin() + 2);
+}
+
+TEST(LowerBoundSimdTest, IntegersLessEqual) {
+    using Traits = jrmwng::algorithm::simd::details::simd_traits<int>;
+    auto const lhs = Traits::setr(0, 1, 2, 3, 4, 5, 6, 7);
+    EXPECT_EQ(Traits::cmp_le(lhs, Traits::set1(3)), 0x0F);
+    EXPECT_EQ(Traits::cmp_ge(lhs, Traits::set1(3)), 0xF8);
+
+    std::vector<int> vec = {-9, -4, -4, 0, 1, 1, 1, 2, 3, 5, 5, 8, 13, 13, 13, 21, 34, 55, 89, 144};
+    std::vector<int> test_values = {-10, -4, 0, 1, 4, 5, 13, 144, 200};
+    for (int value : test_values) {
+        auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, value, std::less_equal<int>());
+        EXPECT_EQ(it_simd, std::lower_bound(vec.begin(), vec.end(), value, std::less_equal<int>())) << value;
+    }
+}
+
+TEST(LowerBoundSimdTest, IntegersGreaterEqual) {
+    std::vector<int> vec = {144, 89, 55, 34, 21, 13, 13, 13, 8, 5, 5, 3, 2, 1, 1, 1, 0, -4, -4, -9};
+    std::vector<int> test_values = {200, 144, 13, 5, 4, 1, 0, -4, -10};
+    for (int value : test_values) {
+        auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, value, std::greater_equal<int>());
+        EXPECT_EQ(it_simd, std::lower_bound(vec.begin(), vec.end(), value, std::greater_equal<int>())) << value;
+    }
+}
+
+TEST(LowerBoundSimdTest, Signed64Integers) {
+    std::vector<int64_t> vec = {INT64_MIN, -(int64_t(1) << 40), -1, 0, 1, 2, int64_t(1) << 40, INT64_MAX};
+    std::vector<int64_t> test_values = {INT64_MIN, -5, 0, 3, int64_t(1) << 40, INT64_MAX};
+    for (int64_t value : test_values) {
+        auto it_simd = jrmwng::algorithm::simd::lower_bound(vec, value);
+        EXPECT_EQ(it_simd, std::lower_bound(vec.begin(), vec.end(), value));
+    }
+}
+
+template <typename Range, typename T, typename... Args>
+concept StrictSearchable = requires(Range &r, T const &value, Args... args) { jrmwng::algorithm::simd::strict::lower_bound(r, value, args...); };
+
+TEST(LowerBoundSimdTest, DispatchReportsEngine) {
+    using jrmwng::algorithm::simd::dispatch_v;
+    using jrmwng::algorithm::simd::engine_kind;
+    struct Key {
+        double value;
+    };
+    auto const by_value = [](Key const &key) { return key.value; };
+    auto const less_int = [](int a, int b) { return a < b; };
+
+    static_assert(dispatch_v<std::vector<int>, int>.engine == engine_kind::vector && dispatch_v<std::vector<int>, int>.fanout == 8);
+    static_assert(dispatch_v<std::vector<double> const &, double, std::greater<double>>.engine == engine_kind::vector);
+    static_assert(dispatch_v<std::span<uint64_t const>, uint64_t>.fanout == 4);
+    static_assert(dispatch_v<std::vector<float>, float, std::less<float>, SquareProjection>.engine == engine_kind::vector);
+    static_assert(dispatch_v<std::vector<Key>, double, std::less<double>, decltype(by_value)>.engine == engine_kind::vector);
+    static_assert(dispatch_v<std::vector<int>, int, decltype(less_int)>.engine == engine_kind::lanes);
+    static_assert(dispatch_v<std::vector<int64_t>, int>.engine == engine_kind::scalar);
+    static_assert(dispatch_v<std::vector<short>, short>.engine == engine_kind::scalar);
+
+    // Only the SIMD engine satisfies the strict overload.
+    static_assert(StrictSearchable<std::vector<int>, int>);
+    static_assert(!StrictSearchable<std::vector<int>, int, decltype(less_int)>);
+    static_assert(!StrictSearchable<std::vector<int64_t>, int>);
+
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    EXPECT_EQ(jrmwng::algorithm::simd::strict::lower_bound(vec, 3), vec.begin() + 2);
+}
+
+TEST(LowerBoundSimdTest, MismatchedValueType) {
+    // Keys of another type than the value are searched by the scalar engine, not packed into lanes of the value's type.
+    std::vector<int64_t> vec;
+    for (int64_t i = 0; i < 100; ++i) {
+        vec.push_back(i << 32);
+    }
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<int64_t>, int, std::less<int64_t>>.engine == jrmwng::algorithm::simd::engine_kind::scalar);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(vec, 5, std::less<int64_t>()), vec.begin() + 1);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(vec, int64_t(5)), vec.begin() + 1);
+
+    struct Key {
+        double value;
+    };
+    std::vector<Key> keys = {{1.1}, {3.3}, {5.5}, {7.7}, {9.9}};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(keys, 6.0, std::less<double>(), [](Key const &key) { return key.value; }), keys.begin() + 3);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_bucketize.hpp"
+#include "lower_bound_set_ops.hpp"
+#include "lower_bound_veb.hpp"
+#include "lower_bound_composite.hpp"
+#include "lower_bound_interleave.hpp"
+#include "lower_bound_two_level.hpp"
+#include "lower_bound_test_utils.hpp"
+
+#if !defined(JRMWNG_ALGORITHM_SIMD_PORTABLE)
+#error "This test is built against the portable backend"
+#endif
+
+template <typename T>
+using Traits = jrmwng::algorithm::simd::details::simd_traits<T>;
+
+template <typename T>
+static std::vector<T> SortedValues(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<T> vec(size);
+    for (auto &x : vec) {
+        x = static_cast<T>(rng() % 5000);
+    }
+    std::ranges::sort(vec);
+    return vec;
+}
+
+TEST(LowerBoundSimdPortableTest, LaneCountsMatchAvx2Backend) {
+    static_assert(Traits<float>::simd_size_v == 8);
+    static_assert(Traits<int>::simd_size_v == 8);
+    static_assert(Traits<uint32_t>::simd_size_v == 8);
+    static_assert(Traits<double>::simd_size_v == 4);
+    static_assert(Traits<int64_t>::simd_size_v == 4);
+    static_assert(Traits<uint64_t>::simd_size_v == 4);
+#if defined(JRMWNG_ALGORITHM_SIMD_EMULATED)
+    EXPECT_TRUE(jrmwng::algorithm::simd::portable::is_emulated_v);
+#endif
+}
+
+TEST(LowerBoundSimdPortableTest, TraitsCompareMasks) {
+    auto const lhs = Traits<int>::setr(0, 1, 2, 3, 4, 5, 6, 7);
+    auto const rhs = Traits<int>::set1(3);
+    EXPECT_EQ(Traits<int>::cmp_lt(lhs, rhs), 0x07);
+    EXPECT_EQ(Traits<int>::cmp_le(lhs, rhs), 0x0F);
+    EXPECT_EQ(Traits<int>::cmp_gt(lhs, rhs), 0xF0);
+    EXPECT_EQ(Traits<int>::cmp_ge(lhs, rhs), 0xF8);
+    EXPECT_EQ(Traits<int>::cmp_eq(lhs, rhs), 0x08);
+    EXPECT_EQ(Traits<int>::extract<5>(lhs), 5);
+
+    auto const ulhs = Traits<uint64_t>::setr(0, 1, UINT64_MAX - 1, UINT64_MAX);
+    EXPECT_EQ(Traits<uint64_t>::cmp_lt(ulhs, Traits<uint64_t>::set1(UINT64_MAX - 1)), 0x3);
+
+    auto const flhs = Traits<float>::setr(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+    EXPECT_EQ(Traits<float>::cmp_ge(flhs, Traits<float>::set1(6.0f)), 0xC0);
+}
+
+TEST(LowerBoundSimdPortableTest, LowerBoundAllTypes) {
+    auto const ints = SortedValues<int>(1000, 1);
+    ExpectMatchesStd(ints, SortedValues<int>(500, 11), [&](int q) { return jrmwng::algorithm::simd::lower_bound(ints, q); });
+    auto const floats = SortedValues<float>(1000, 2);
+    ExpectMatchesStd(floats, SortedValues<float>(500, 12), [&](float q) { return jrmwng::algorithm::simd::lower_bound(floats, q); });
+    auto const doubles = SortedValues<double>(1000, 3);
+    ExpectMatchesStd(doubles, SortedValues<double>(500, 13), [&](double q) { return jrmwng::algorithm::simd::lower_bound(doubles, q); });
+    auto const int64s = SortedValues<int64_t>(1000, 4);
+    ExpectMatchesStd(int64s, SortedValues<int64_t>(500, 14), [&](int64_t q) { return jrmwng::algorithm::simd::lower_bound(int64s, q); });
+    auto const uint32s = SortedValues<uint32_t>(1000, 5);
+    ExpectMatchesStd(uint32s, SortedValues<uint32_t>(500, 15), [&](uint32_t q) { return jrmwng::algorithm::simd::lower_bound(uint32s, q); });
+    auto const uint64s = SortedValues<uint64_t>(1000, 6);
+    ExpectMatchesStd(uint64s, SortedValues<uint64_t>(500, 16), [&](uint64_t q) { return jrmwng::algorithm::simd::lower_bound(uint64s, q); });
+
+    auto descending = SortedValues<int>(1000, 7);
+    std::ranges::reverse(descending);
+    auto queries = SortedValues<int>(500, 17);
+    ExpectMatchesStd(descending, queries, [&](int q) { return jrmwng::algorithm::simd::lower_bound(descending, q, std::greater<int>()); }, std::greater<int>());
+}
+
+TEST(LowerBoundSimdPortableTest, LessEqualAndGreaterEqual) {
+    std::vector<int> vec = {-9, -4, -4, 0, 1, 1, 1, 2, 3, 5, 5, 8, 13, 13, 13, 21, 34, 55, 89, 144};
+    std::vector<int> test_values = {-10, -4, 0, 1, 4, 5, 13, 144, 200};
+    for (int value : test_values) {
+        auto it = jrmwng::algorithm::simd::lower_bound(vec, value, std::less_equal<int>());
+        EXPECT_EQ(it, std::lower_bound(vec.begin(), vec.end(), value, std::less_equal<int>())) << value;
+    }
+    std::ranges::reverse(vec);
+    for (int value : test_values) {
+        auto it = jrmwng::algorithm::simd::lower_bound(vec, value, std::greater_equal<int>());
+        EXPECT_EQ(it, std::lower_bound(vec.begin(), vec.end(), value, std::greater_equal<int>())) << value;
+    }
+}
+
+TEST(LowerBoundSimdPortableTest, VectorProjection) {
+    std::vector<int> vec = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    auto const it = jrmwng::algorithm::simd::lower_bound(vec, 3, std::less<int>(), [](Traits<int>::simd_type const &v) { return v; });
+    EXPECT_EQ(it - vec.begin(), 2);
+}
+
+TEST(LowerBoundSimdPortableTest, DependentHeaders) {
+    std::vector<int> boundaries = {10, 20, 30};
+    std::vector<int> values = {5, 10, 25, 40};
+    std::vector<int> buckets(values.size());
+    jrmwng::algorithm::simd::bucketize(boundaries, values, buckets);
+    EXPECT_EQ(buckets, (std::vector<int>{0, 0, 2, 3}));
+
+    auto const a = SortedValues<uint32_t>(300, 8);
+    auto const b = SortedValues<uint32_t>(300, 9);
+    std::vector<uint32_t> expected;
+    std::ranges::set_intersection(a, b, std::back_inserter(expected));
+    EXPECT_EQ(jrmwng::algorithm::sets::count_intersection(a, b), expected.size());
+
+    auto const vec = SortedValues<double>(3000, 10);
+    jrmwng::algorithm::layout::veb_layout_t<double> veb(vec);
+    EXPECT_EQ(veb.lower_bound(2500.0), static_cast<size_t>(std::lower_bound(vec.begin(), vec.end(), 2500.0) - vec.begin()));
+
+    std::vector<int> tenant = {1, 1, 2, 2};
+    std::vector<int64_t> timestamp = {10, 20, 5, 15};
+    jrmwng::algorithm::composite::columns_t columns(tenant, timestamp);
+    EXPECT_EQ(columns.lower_bound(2, int64_t(10)), 3u);
+
+    std::vector<size_t> results(1);
+    auto const ints = SortedValues<int>(1000, 11);
+    jrmwng::algorithm::interleave::run(1, 1, [&](size_t) { return jrmwng::algorithm::interleave::lower_bound(ints, 2500); }, results.begin());
+    EXPECT_EQ(results[0], static_cast<size_t>(std::lower_bound(ints.begin(), ints.end(), 2500) - ints.begin()));
+
+    jrmwng::algorithm::layout::two_level_index_t<int> two_level(ints);
+    EXPECT_EQ(two_level.lower_bound(2500), results[0]);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
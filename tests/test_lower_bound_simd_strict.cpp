@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <array>
+#include <span>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "lower_bound_simd.hpp"
+#include "lower_bound_time_series.hpp"
+#include "lower_bound_test_utils.hpp"
+
+// Built with JRMWNG_ALGORITHM_SIMD_STRICT: every simd::lower_bound instantiated here must take the vector engine, or this
+// file does not compile.
+#if !defined(JRMWNG_ALGORITHM_SIMD_STRICT)
+#error "Build this test with JRMWNG_ALGORITHM_SIMD_STRICT defined"
+#endif
+
+TEST(LowerBoundSimdStrictTest, AllKeyTypes) {
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<int> &, int, std::less<int>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<int> &, int, std::greater<int>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<uint32_t> &, uint32_t, std::less<uint32_t>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<float> &, float, std::less<float>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<double> &, double, std::greater<double>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<int64_t> &, int64_t, std::less<int64_t>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+    static_assert(jrmwng::algorithm::simd::dispatch_v<std::vector<uint64_t> &, uint64_t, std::less<uint64_t>>.engine == jrmwng::algorithm::simd::engine_kind::vector);
+
+    std::vector<int> ints(1000);
+    for (size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = static_cast<int>(i) * 2 - 1000;
+    }
+    ExpectMatchesStd(ints, {-1001, -1000, 0, 3, 499, 1000}, [&](int q) { return jrmwng::algorithm::simd::lower_bound(ints, q, std::less<int>()); });
+    std::ranges::reverse(ints);
+    ExpectMatchesStd(ints, {-1001, -1000, 0, 3, 499, 1000}, [&](int q) { return jrmwng::algorithm::simd::lower_bound(ints, q, std::greater<int>()); }, std::greater<int>());
+
+    std::vector<uint32_t> u32 = {0, 1, 2, 3, 0x7fffffffu, 0x80000000u, 0xfffffffeu, 0xffffffffu};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u32, 0u, std::less<uint32_t>()), u32.begin());
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u32, 2u, std::less<uint32_t>()), u32.begin() + 2);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u32, 0x80000000u, std::less<uint32_t>()), u32.begin() + 5);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u32, 0xffffffffu, std::less<uint32_t>()), u32.begin() + 7);
+
+    std::vector<float> floats = {-2.5f, -1.0f, 0.0f, 0.5f, 1.5f, 3.0f, 8.0f, 100.0f, 1e6f};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(floats, -3.0f, std::less<float>()), floats.begin());
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(floats, 0.5f, std::less<float>()), floats.begin() + 3);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(floats, 2.0f, std::less<float>()), floats.begin() + 5);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(floats, 1e7f, std::less<float>()), floats.end());
+
+    std::vector<double> doubles = {1e6, 100.0, 8.0, 3.0, 1.5, 0.5, 0.0, -1.0, -2.5};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(doubles, 1e7, std::greater<double>()), doubles.begin());
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(doubles, 2.0, std::greater<double>()), doubles.begin() + 4);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(doubles, 0.5, std::greater<double>()), doubles.begin() + 5);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(doubles, -3.0, std::greater<double>()), doubles.end());
+
+    std::vector<int64_t> i64 = {INT64_MIN, -(int64_t(1) << 40), -1, 0, 1, int64_t(1) << 40, INT64_MAX};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(i64, INT64_MIN, std::less<int64_t>()), i64.begin());
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(i64, int64_t(-5), std::less<int64_t>()), i64.begin() + 2);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(i64, int64_t(1) << 40, std::less<int64_t>()), i64.begin() + 5);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(i64, INT64_MAX, std::less<int64_t>()), i64.begin() + 6);
+
+    std::vector<uint64_t> u64 = {0, 1, uint64_t(1) << 63, UINT64_MAX - 1, UINT64_MAX};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u64, uint64_t(0), std::less<uint64_t>()), u64.begin());
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u64, uint64_t(2), std::less<uint64_t>()), u64.begin() + 2);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u64, uint64_t(1) << 63, std::less<uint64_t>()), u64.begin() + 2);
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(u64, UINT64_MAX, std::less<uint64_t>()), u64.begin() + 4);
+}
+
+TEST(LowerBoundSimdStrictTest, RangesAndProjections) {
+    std::array<int, 64> node{};
+    for (size_t i = 0; i < node.size(); ++i) {
+        node[i] = static_cast<int>(i * 2);
+    }
+    std::span<int const> const span(node);
+    for (int q = -1; q < 130; q += 3) {
+        auto const expected = std::lower_bound(node.begin(), node.end(), q) - node.begin();
+        EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(node, q) - node.begin(), expected) << q;
+        EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(span, q) - span.begin(), expected) << q;
+        EXPECT_EQ(jrmwng::algorithm::simd::strict::lower_bound(span, q) - span.begin(), expected) << q;
+    }
+
+    // Keys projected one at a time to the value type still reach the comparison as SIMD lanes.
+    struct Key {
+        double value;
+    };
+    std::vector<Key> keys = {{1.1}, {3.3}, {5.5}, {7.7}, {9.9}};
+    EXPECT_EQ(jrmwng::algorithm::simd::lower_bound(keys, 6.0, std::less<double>(), [](Key const &key) { return key.value; }), keys.begin() + 3);
+}
+
+TEST(LowerBoundSimdStrictTest, HeadersSearchingThroughSimd) {
+    // time_series_t searches with simd::lower_bound, so it instantiates the strict check for its key type.
+    jrmwng::algorithm::concurrent::time_series_t<int64_t> series(16, 16);
+    for (int64_t t = 0; t < 100; ++t) {
+        series.append(t * 10);
+    }
+    EXPECT_EQ(series.lower_bound(55), 6u);
+    EXPECT_EQ(series.lower_bound_recent(985), 99u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include "lower_bound_snapshot.hpp"
+
+TEST(LowerBoundSnapshotTest, Integers) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>> snapshot(std::vector<int>{1, 2, 4, 5, 6});
+    std::vector<int> test_values = {3, 0, 7};
+    std::vector<size_t> expected_indices = {2, 0, 5};
+    for (size_t i = 0; i < test_values.size(); ++i) {
+        EXPECT_EQ(snapshot.lower_bound(test_values[i]), expected_indices[i]);
+    }
+}
+
+TEST(LowerBoundSnapshotTest, DoublesWithProjection) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<double>> snapshot(std::vector<double>{1.1, 2.2, 4.4, 5.5, 6.6});
+    EXPECT_EQ(snapshot.lower_bound(3.3, std::less<double>(), [](double d) { return d; }), 2u);
+}
+
+TEST(LowerBoundSnapshotTest, EmptyVector) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>> snapshot;
+    EXPECT_EQ(snapshot.lower_bound(1), 0u);
+}
+
+TEST(LowerBoundSnapshotTest, PublishSwapsVersion) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>> snapshot(std::vector<int>{1, 2, 4});
+    EXPECT_EQ(snapshot.lower_bound(3), 2u);
+    snapshot.publish(std::vector<int>{0, 1, 2, 3, 4});
+    EXPECT_EQ(snapshot.lower_bound(3), 3u);
+    EXPECT_EQ(snapshot.retired(), 0u);
+}
+
+TEST(LowerBoundSnapshotTest, ReaderKeepsOldVersionAlive) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>> snapshot(std::vector<int>{1, 2, 4});
+    {
+        auto reader = snapshot.read();
+        snapshot.publish(std::vector<int>{10, 20});
+        EXPECT_EQ(snapshot.retired(), 1u);
+        EXPECT_EQ(reader->size(), 3u);
+        EXPECT_EQ((*reader)[2], 4);
+        EXPECT_EQ(snapshot.reclaim(), 0u);
+
+        // A reader entering after the publish sees the new version and does not block reclamation of the old one.
+        auto later = snapshot.read();
+        EXPECT_EQ(later->size(), 2u);
+    }
+    EXPECT_EQ(snapshot.reclaim(), 1u);
+    EXPECT_EQ(snapshot.retired(), 0u);
+}
+
+TEST(LowerBoundSnapshotTest, MoreReadersThanSlots) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>, 4> snapshot(std::vector<int>{1, 2, 4});
+    {
+        // Holding every slot must not livelock further (e.g. nested) reads; they pin through the overflow list.
+        std::vector<std::optional<jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>, 4>::reader_t>> readers;
+        for (int i = 0; i < 6; ++i) {
+            readers.emplace_back(snapshot.read());
+        }
+        EXPECT_EQ(snapshot.lower_bound(3), 2u);
+        snapshot.publish(std::vector<int>{10, 20});
+        for (auto const &reader : readers) {
+            EXPECT_EQ((*reader)->size(), 3u);
+        }
+        EXPECT_EQ(snapshot.reclaim(), 0u);
+
+        // Releasing only the slot readers still leaves the old version pinned by the overflow readers.
+        for (int i = 0; i < 4; ++i) {
+            readers[i].reset();
+        }
+        EXPECT_EQ(snapshot.reclaim(), 0u);
+        EXPECT_EQ((*readers.back())->size(), 3u);
+    }
+    EXPECT_EQ(snapshot.reclaim(), 1u);
+    EXPECT_EQ(snapshot.lower_bound(15), 1u);
+}
+
+TEST(LowerBoundSnapshotTest, RebuildAsync) {
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>> snapshot(std::vector<int>{1, 2, 4});
+    auto future = snapshot.rebuild_async([](std::vector<int> const &current) {
+        std::vector<int> next = current;
+        next.insert(next.begin() + 2, 3);
+        return next;
+    });
+    future.get();
+    EXPECT_EQ(snapshot.lower_bound(4), 3u);
+}
+
+TEST(LowerBoundSnapshotTest, ConcurrentReadersSeeConsistentVersions) {
+    auto make_version = [](int version) {
+        std::vector<int> vec(1000);
+        for (size_t i = 0; i < vec.size(); ++i) {
+            vec[i] = version * 10000 + static_cast<int>(i) * 2;
+        }
+        return vec;
+    };
+    jrmwng::algorithm::concurrent::snapshot_t<std::vector<int>, 8> snapshot(make_version(0));
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                auto reader = snapshot.read();
+                int const base = reader->front();
+                auto it = jrmwng::algorithm::simd::lower_bound(*reader, base + 501);
+                if (it - reader->begin() != 251 || reader->back() != base + 1998) {
+                    ++inconsistent;
+                }
+            }
+        });
+    }
+    for (int version = 1; version <= 200; ++version) {
+        snapshot.publish(make_version(version));
+    }
+    stop.store(true);
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(inconsistent.load(), 0);
+    snapshot.reclaim();
+    EXPECT_EQ(snapshot.retired(), 0u);
+    EXPECT_EQ(snapshot.lower_bound(200 * 10000), 0u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
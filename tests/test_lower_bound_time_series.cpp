@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include "lower_bound_time_series.hpp"
+#include "lower_bound_test_utils.hpp"
+
+TEST(LowerBoundTimeSeriesTest, Basic) {
+    jrmwng::algorithm::concurrent::time_series_t<int64_t> series(4, 16);
+    EXPECT_EQ(series.lower_bound(5), 0u);
+    EXPECT_EQ(series.lower_bound_recent(5), 0u);
+    for (int64_t t : {10, 20, 20, 30, 40, 50}) {
+        series.append(t);
+    }
+    EXPECT_EQ(series.size(), 6u);
+    EXPECT_EQ(series.capacity(), 64u);
+    EXPECT_EQ(series[3], 30);
+    EXPECT_EQ(series.lower_bound(20), 1u);
+    EXPECT_EQ(series.lower_bound(21), 3u);
+    EXPECT_EQ(series.lower_bound_recent(45), 5u);
+    EXPECT_EQ(series.lower_bound_recent(60), 6u);
+    EXPECT_EQ(series.lower_bound_recent(0), 0u);
+}
+
+TEST(LowerBoundTimeSeriesTest, AllSizesAcrossChunks) {
+    jrmwng::algorithm::concurrent::time_series_t<int> series(16, 64);
+    std::vector<int> vec;
+    for (int i = 0; i < 300; ++i) {
+        int const t = i / 3 * 2;
+        series.append(t);
+        vec.push_back(t);
+        std::vector<int> queries;
+        for (int q = -1; q <= t + 1; ++q) {
+            queries.push_back(q);
+        }
+        ASSERT_EQ(series.size(), vec.size());
+        SCOPED_TRACE(vec.size());
+        ExpectMatchesStd(vec, queries, [&](int q) { return series.lower_bound(q); });
+        ExpectMatchesStd(vec, queries, [&](int q) { return series.lower_bound_recent(q); });
+    }
+}
+
+TEST(LowerBoundTimeSeriesTest, BatchAppendAndOtherTypes) {
+    std::mt19937_64 rng(5);
+    std::vector<double> vec(100000);
+    for (double &x : vec) {
+        x = static_cast<double>(rng() % 50000) / 8;
+    }
+    std::sort(vec.begin(), vec.end());
+    jrmwng::algorithm::concurrent::time_series_t<double> series(1024, 128);
+    series.reserve(vec.size());
+    for (size_t i = 0; i < vec.size(); i += 777) {
+        series.append(std::span<double const>(vec).subspan(i, std::min<size_t>(777, vec.size() - i)));
+    }
+    std::vector<double> queries = {-1.0, 1e9};
+    for (size_t i = 0; i < 1000; ++i) {
+        queries.push_back(vec[rng() % vec.size()] + 0.0625 * static_cast<double>(rng() % 3));
+        queries.push_back(vec[vec.size() - 1 - rng() % 3000]);
+    }
+    ASSERT_EQ(series.size(), vec.size());
+    ExpectMatchesStd(vec, queries, [&](double q) { return series.lower_bound(q); });
+    ExpectMatchesStd(vec, queries, [&](double q) { return series.lower_bound_recent(q); });
+
+    jrmwng::algorithm::concurrent::time_series_t<uint32_t, std::greater<uint32_t>> descending(8, 8);
+    std::vector<uint32_t> down = {90, 80, 80, 70, 60, 50, 40, 30, 20, 10};
+    descending.append(down);
+    EXPECT_EQ(descending.lower_bound(100), 0u);
+    EXPECT_EQ(descending.lower_bound(80), 1u);
+    EXPECT_EQ(descending.lower_bound_recent(80), 1u);
+    EXPECT_EQ(descending.lower_bound(75), 3u);
+    EXPECT_EQ(descending.lower_bound_recent(10), 9u);
+    EXPECT_EQ(descending.lower_bound_recent(5), 10u);
+}
+
+TEST(LowerBoundTimeSeriesTest, RejectsOutOfOrderAndOverflow) {
+    jrmwng::algorithm::concurrent::time_series_t<int> series(4, 2);
+    series.append(5);
+    EXPECT_THROW(series.append(4), std::invalid_argument);
+    std::vector<int> unsorted = {6, 8, 7};
+    EXPECT_THROW(series.append(unsorted), std::invalid_argument);
+    EXPECT_EQ(series.size(), 1u);
+    std::vector<int> many = {6, 7, 8, 9, 10, 11, 12, 13};
+    EXPECT_THROW(series.append(many), std::length_error);
+    EXPECT_EQ(series.size(), 1u);
+    series.append(std::span<int const>(many).first(7));
+    EXPECT_EQ(series.size(), 8u);
+    EXPECT_THROW(series.append(20), std::length_error);
+    EXPECT_THROW(series.reserve(9), std::length_error);
+    EXPECT_THROW((jrmwng::algorithm::concurrent::time_series_t<int>(6)), std::invalid_argument);
+}
+
+// A key whose default construction, i.e. the allocation of a chunk, fails once a countdown reaches zero.
+struct FallibleKey {
+    static inline int fail_after = -1;
+    int value = 0;
+    FallibleKey() {
+        if (fail_after == 0) {
+            throw std::bad_alloc();
+        }
+        if (fail_after > 0) {
+            --fail_after;
+        }
+    }
+    FallibleKey(int v) : value(v) {}
+    bool operator<(FallibleKey const &that) const {
+        return value < that.value;
+    }
+};
+
+TEST(LowerBoundTimeSeriesTest, FailedBatchAppendsNothing) {
+    jrmwng::algorithm::concurrent::time_series_t<FallibleKey> series(4, 8);
+    series.append(FallibleKey(0));
+    std::vector<FallibleKey> batch;
+    for (int i = 1; i <= 10; ++i) {
+        batch.emplace_back(i);
+    }
+    FallibleKey::fail_after = 4; // The batch's first new chunk is allocated, its second is not.
+    EXPECT_THROW(series.append(batch), std::bad_alloc);
+    FallibleKey::fail_after = -1;
+    EXPECT_EQ(series.size(), 1u);
+
+    series.append(batch);
+    EXPECT_EQ(series.size(), 11u);
+    for (int i = 0; i <= 10; ++i) {
+        EXPECT_EQ(series[static_cast<size_t>(i)].value, i);
+        EXPECT_EQ(series.lower_bound(FallibleKey(i)), static_cast<size_t>(i));
+    }
+}
+
+TEST(LowerBoundTimeSeriesTest, ConcurrentReadersSeePublishedPrefix) {
+    constexpr int64_t count_v = 200000;
+    jrmwng::algorithm::concurrent::time_series_t<int64_t> series(256, 1024);
+    std::atomic<bool> bDone = false;
+    std::atomic<size_t> uErrors = 0;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            std::mt19937_64 rng(r);
+            while (!bDone.load(std::memory_order_acquire)) {
+                size_t const size = series.size();
+                if (size == 0) {
+                    continue;
+                }
+                // Key i is 2 * i, so the lower bound of 2 * k + 1 is k + 1 for every published k.
+                int64_t const k = static_cast<int64_t>(rng() % size);
+                size_t const expected = static_cast<size_t>(k + 1);
+                uErrors += series.lower_bound(2 * k + 1) != expected;
+                uErrors += series.lower_bound_recent(2 * k + 1) != expected;
+                uErrors += series[static_cast<size_t>(k)] != 2 * k;
+            }
+        });
+    }
+    for (int64_t i = 0; i < count_v; ++i) {
+        series.append(2 * i);
+    }
+    bDone.store(true, std::memory_order_release);
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(uErrors.load(), 0u);
+    EXPECT_EQ(series.size(), static_cast<size_t>(count_v));
+    EXPECT_EQ(series.lower_bound(2 * count_v - 2), static_cast<size_t>(count_v - 1));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include "lower_bound_tune.hpp"
+#include "lower_bound_test_utils.hpp"
+
+TEST(LowerBoundTuneTest, EveryFanoutMatchesStdIntegers) {
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i / 3) * 2;
+    }
+    std::vector<int> test_values = {-1, 0, 1, 2, 3, 100, 331, 332, 333, 664, 665, 10000};
+    for (uint32_t fanout : {1u, 2u, 4u, 8u, 16u}) {
+        jrmwng::algorithm::tune::tuned_search_t<int> search({std::string(jrmwng::algorithm::tune::details::key_name_v<int>), 0, fanout});
+        SCOPED_TRACE(fanout);
+        ExpectMatchesStd(vec, test_values, [&](int value) { return search(vec, value); });
+    }
+}
+
+TEST(LowerBoundTuneTest, EveryFanoutMatchesStdFloats) {
+    std::vector<float> vec(257);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<float>(i) * 0.5f;
+    }
+    std::vector<float> test_values = {-1.0f, 0.0f, 0.25f, 64.0f, 64.1f, 128.0f, 128.5f};
+    for (uint32_t fanout : {1u, 2u, 4u, 8u, 16u}) {
+        jrmwng::algorithm::tune::tuned_search_t<float> search({std::string(jrmwng::algorithm::tune::details::key_name_v<float>), 0, fanout});
+        SCOPED_TRACE(fanout);
+        ExpectMatchesStd(vec, test_values, [&](float value) { return search(vec, value); });
+    }
+}
+
+TEST(LowerBoundTuneTest, EveryFanoutMatchesStdDoubles) {
+    std::vector<double> vec(100);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<double>(i) * 1.1;
+    }
+    std::vector<double> test_values = {-1.0, 0.0, 1.1, 50.0, 108.9, 200.0};
+    for (uint32_t fanout : {1u, 2u, 4u, 8u, 16u}) {
+        jrmwng::algorithm::tune::tuned_search_t<double> search({std::string(jrmwng::algorithm::tune::details::key_name_v<double>), 0, fanout});
+        SCOPED_TRACE(fanout);
+        ExpectMatchesStd(vec, test_values, [&](double value) { return search(vec, value); });
+    }
+}
+
+TEST(LowerBoundTuneTest, TunePicksCandidateFanout) {
+    std::vector<int> vec(4096);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i) * 3;
+    }
+    auto search = jrmwng::algorithm::tune::tune(vec, {256, 1, 7});
+    EXPECT_EQ(search.profile().key, "int");
+    EXPECT_EQ(search.profile().size_class, 13u);
+    EXPECT_TRUE(jrmwng::algorithm::tune::details::is_candidate_fanout(search.fanout(), jrmwng::algorithm::tune::details::fanout_sequence_type{})) << search.fanout();
+    EXPECT_EQ(search(vec, 3001), vec.begin() + 1001);
+}
+
+TEST(LowerBoundTuneTest, EveryFanoutMatchesStd64BitIntegers) {
+    std::vector<uint64_t> vec(500);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = (uint64_t(1) << 63) - 1000 + i * 7;
+    }
+    std::vector<uint64_t> test_values = {0, vec[0], vec[0] + 1, uint64_t(1) << 63, vec[499], UINT64_MAX};
+    for (uint32_t fanout : {1u, 2u, 4u, 8u, 16u}) {
+        jrmwng::algorithm::tune::tuned_search_t<uint64_t> search({std::string(jrmwng::algorithm::tune::details::key_name_v<uint64_t>), 0, fanout});
+        SCOPED_TRACE(fanout);
+        ExpectMatchesStd(vec, test_values, [&](uint64_t value) { return search(vec, value); });
+    }
+
+    std::vector<int64_t> signed_vec = {INT64_MIN, -5, -1, 0, 7, INT64_MAX};
+    for (uint32_t fanout : {1u, 2u, 4u, 8u, 16u}) {
+        jrmwng::algorithm::tune::tuned_search_t<int64_t> search({std::string(jrmwng::algorithm::tune::details::key_name_v<int64_t>), 0, fanout});
+        SCOPED_TRACE(fanout);
+        ExpectMatchesStd(signed_vec, {INT64_MIN, -2, 0, 8, INT64_MAX}, [&](int64_t value) { return search(signed_vec, value); });
+    }
+    EXPECT_EQ(jrmwng::algorithm::tune::tune(signed_vec, {64, 1, 1}).profile().key, "int64_t");
+}
+
+TEST(LowerBoundTuneTest, EmptyVector) {
+    std::vector<double> empty_vec;
+    auto search = jrmwng::algorithm::tune::tune(empty_vec);
+    EXPECT_EQ(search.fanout(), 1u);
+    EXPECT_EQ(search(empty_vec, 1.0), empty_vec.begin());
+}
+
+TEST(LowerBoundTuneTest, ProfileRoundTrip) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_tune_round_trip.profile";
+    jrmwng::algorithm::tune::search_profile const profile{"float", 20, 8};
+    ASSERT_TRUE(jrmwng::algorithm::tune::save_profile(path, profile));
+
+    auto loaded = jrmwng::algorithm::tune::load_profile(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->key, "float");
+    EXPECT_EQ(loaded->size_class, 20u);
+    EXPECT_EQ(loaded->fanout, 8u);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundTuneTest, MissingProfile) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_tune_missing.profile";
+    std::filesystem::remove(path);
+    EXPECT_FALSE(jrmwng::algorithm::tune::load_profile(path).has_value());
+}
+
+TEST(LowerBoundTuneTest, MatchingProfileSkipsTuning) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_tune_matching.profile";
+    std::vector<int> vec(100);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+    ASSERT_TRUE(jrmwng::algorithm::tune::save_profile(path, {"int", 7, 16}));
+    // A line save_profile never writes proves the file was used as-is rather than retuned and saved again.
+    std::ofstream(path, std::ios::app) << "# kept\n";
+    auto search = jrmwng::algorithm::tune::tune(vec, path);
+    EXPECT_EQ(search.fanout(), 16u);
+    EXPECT_EQ(search(vec, 42), vec.begin() + 42);
+    std::ifstream ifs(path);
+    std::string const contents((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_NE(contents.find("# kept"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundTuneTest, NonCandidateFanoutIsRejected) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_tune_non_candidate.profile";
+    ASSERT_TRUE(jrmwng::algorithm::tune::save_profile(path, {"int", 7, 3}));
+    EXPECT_FALSE(jrmwng::algorithm::tune::load_profile(path).has_value());
+    EXPECT_THROW(jrmwng::algorithm::tune::tuned_search_t<int>({"int", 7, 3}), std::invalid_argument);
+
+    std::vector<int> vec(100);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+    auto search = jrmwng::algorithm::tune::tune(vec, path, {64, 1, 1});
+    EXPECT_NE(search.fanout(), 3u);
+    EXPECT_EQ(jrmwng::algorithm::tune::load_profile(path)->fanout, search.fanout());
+    std::filesystem::remove(path);
+}
+
+TEST(LowerBoundTuneTest, MismatchedProfileIsRetunedAndSaved) {
+    auto const path = std::filesystem::temp_directory_path() / "lower_bound_tune_mismatched.profile";
+    std::vector<int> vec(100);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+    ASSERT_TRUE(jrmwng::algorithm::tune::save_profile(path, {"double", 7, 3}));
+    auto search = jrmwng::algorithm::tune::tune(vec, path, {64, 1, 1});
+    EXPECT_NE(search.fanout(), 3u);
+
+    auto loaded = jrmwng::algorithm::tune::load_profile(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->key, "int");
+    EXPECT_EQ(loaded->size_class, 7u);
+    EXPECT_EQ(loaded->fanout, search.fanout());
+    std::filesystem::remove(path);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
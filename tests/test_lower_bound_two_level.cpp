@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <climits>
+#include "lower_bound_two_level.hpp"
+#include "lower_bound_test_utils.hpp"
+
+TEST(LowerBoundTwoLevelTest, Integers) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    jrmwng::algorithm::layout::two_level_index_t<int> index(vec);
+    EXPECT_EQ(index.lower_bound(3), 2u);
+    EXPECT_EQ(index.lower_bound(0), 0u);
+    EXPECT_EQ(index.lower_bound(7), 5u);
+    EXPECT_EQ(index.lower_bound(1), 0u);
+    EXPECT_EQ(index.lower_bound(6), 4u);
+}
+
+TEST(LowerBoundTwoLevelTest, EmptyVector) {
+    std::vector<int64_t> empty_vec;
+    jrmwng::algorithm::layout::two_level_index_t<int64_t> index(empty_vec);
+    EXPECT_EQ(index.lower_bound(1), 0u);
+}
+
+TEST(LowerBoundTwoLevelTest, RandomSigned64) {
+    std::mt19937_64 rng(7);
+    std::vector<int64_t> vec(200000);
+    for (int64_t &key : vec) {
+        key = static_cast<int64_t>(rng());
+    }
+    std::ranges::sort(vec);
+
+    std::vector<int64_t> test_values = {INT64_MIN, INT64_MAX, vec.front(), vec.back(), vec.front() - 1};
+    for (int i = 0; i < 2000; ++i) {
+        test_values.push_back(vec[rng() % vec.size()]);
+        test_values.push_back(static_cast<int64_t>(rng()));
+    }
+    jrmwng::algorithm::layout::two_level_index_t<int64_t> index(vec);
+    ExpectMatchesStd(vec, test_values, [&](int64_t value) { return index.lower_bound(value); });
+}
+
+TEST(LowerBoundTwoLevelTest, SmallRangeManyDuplicates) {
+    std::vector<int64_t> vec(100000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int64_t>(i / 1000) - 50;
+    }
+    std::vector<int64_t> test_values;
+    for (int64_t value = -60; value < 60; ++value) {
+        test_values.push_back(value);
+    }
+    for (size_t block : {64u, 4096u}) {
+        jrmwng::algorithm::layout::two_level_index_t<int64_t> index(vec, block);
+        SCOPED_TRACE(block);
+        ExpectMatchesStd(vec, test_values, [&](int64_t value) { return index.lower_bound(value); });
+        for (int64_t value : test_values) {
+            auto const [first, last] = index.block_range(value);
+            EXPECT_LE(first, index.lower_bound(value)) << value;
+            EXPECT_GE(last, index.lower_bound(value)) << value;
+        }
+    }
+}
+
+TEST(LowerBoundTwoLevelTest, DeepTree) {
+    // Block size 1 builds several tree levels even for a moderate array.
+    std::vector<int> vec(20000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i) * 7 - 70000;
+    }
+    std::vector<int> test_values;
+    for (int value = -70010; value < 70010; value += 97) {
+        test_values.push_back(value);
+    }
+    jrmwng::algorithm::layout::two_level_index_t<int> index(vec, 1);
+    ExpectMatchesStd(vec, test_values, [&](int value) { return index.lower_bound(value); });
+}
+
+TEST(LowerBoundTwoLevelTest, WholeNodesOfSummaries) {
+    // 2048 keys in blocks of 64 give 32 summaries, whole nodes at 16 or 32 lanes.
+    std::vector<int> vec(2048);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+    jrmwng::algorithm::layout::two_level_index_t<int> index(vec, 64);
+    ExpectMatchesStd(vec, {-1, 0, 1983, 1984, 1985, 2047, 2048, 5000, INT_MAX}, [&](int value) { return index.lower_bound(value); });
+
+    // Block size 1 puts 16 * 16 summaries in the lowest level under two levels of whole nodes.
+    vec.resize(256);
+    jrmwng::algorithm::layout::two_level_index_t<int> deep(vec, 1);
+    ExpectMatchesStd(vec, {-1, 0, 128, 255, 256, INT_MAX}, [&](int value) { return deep.lower_bound(value); });
+}
+
+TEST(LowerBoundTwoLevelTest, Doubles) {
+    std::vector<double> vec_d(5000);
+    for (size_t i = 0; i < vec_d.size(); ++i) {
+        vec_d[i] = (static_cast<double>(i) - 2500.0) * 0.37;
+    }
+    jrmwng::algorithm::layout::two_level_index_t<double> index(vec_d, 64);
+    ExpectMatchesStd(vec_d, {-1e9, -925.0, -0.0, 0.0, 0.37, 3.3, 924.0, 1e9}, [&](double value) { return index.lower_bound(value); });
+}
+
+TEST(LowerBoundTwoLevelTest, SummariesFitInL1) {
+    std::vector<int64_t> vec(10000000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int64_t>(i) * 1000;
+    }
+    jrmwng::algorithm::layout::two_level_index_t<int64_t> index(vec);
+    EXPECT_LE(index.summary_bytes(), 32u * 1024u);
+    EXPECT_EQ(index.lower_bound(5000001), 5001u);
+    EXPECT_EQ(index.lower_bound(int64_t(9999999) * 1000), 9999999u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
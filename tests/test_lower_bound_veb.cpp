@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "lower_bound_veb.hpp"
+#include "lower_bound_test_utils.hpp"
+
+TEST(LowerBoundVebTest, Basic) {
+    std::vector<int> vec = {1, 2, 4, 5, 6};
+    jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+    EXPECT_EQ(veb.lower_bound(0), 0u);
+    EXPECT_EQ(veb.lower_bound(3), 2u);
+    EXPECT_EQ(veb.lower_bound(6), 4u);
+    EXPECT_EQ(veb.lower_bound(7), 5u);
+}
+
+TEST(LowerBoundVebTest, Empty) {
+    std::vector<int> vec;
+    jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+    EXPECT_EQ(veb.lower_bound(3), 0u);
+}
+
+TEST(LowerBoundVebTest, AllSizesUpToSeveralLevels) {
+    // Heights 1 to 4 for 8-key nodes, including sizes on both sides of every complete tree.
+    for (size_t size : {1, 2, 7, 8, 9, 80, 81, 100, 728, 729, 730, 1000, 6560, 6561, 7000}) {
+        std::vector<int> vec(size);
+        for (size_t i = 0; i < size; ++i) {
+            vec[i] = static_cast<int>(2 * i);
+        }
+        std::vector<int> queries;
+        for (int q = -1; q <= static_cast<int>(2 * size); ++q) {
+            queries.push_back(q);
+        }
+        jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+        ASSERT_EQ(veb.size(), vec.size());
+        SCOPED_TRACE(size);
+        ExpectMatchesStd(vec, queries, [&](int q) { return veb.lower_bound(q); });
+    }
+}
+
+TEST(LowerBoundVebTest, RandomWithDuplicates) {
+    std::mt19937 rng(11);
+    for (size_t size : {50, 3000, 100000}) {
+        std::vector<int> vec(size);
+        for (auto &x : vec) {
+            x = static_cast<int>(rng() % (size / 2 + 1));
+        }
+        std::ranges::sort(vec);
+        std::vector<int> queries(2000);
+        for (auto &q : queries) {
+            q = static_cast<int>(rng() % (size / 2 + 3)) - 1;
+        }
+        jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+        SCOPED_TRACE(size);
+        ExpectMatchesStd(vec, queries, [&](int q) { return veb.lower_bound(q); });
+    }
+}
+
+TEST(LowerBoundVebTest, OtherKeyTypes) {
+    std::mt19937 rng(12);
+    std::vector<double> doubles(5000);
+    std::vector<float> floats(5000);
+    std::vector<uint64_t> u64s(5000);
+    for (size_t i = 0; i < 5000; ++i) {
+        doubles[i] = static_cast<double>(rng() % 10000) / 7.0;
+        floats[i] = static_cast<float>(rng() % 10000) / 3.0f;
+        u64s[i] = (static_cast<uint64_t>(rng()) << 32) | rng();
+    }
+    std::ranges::sort(doubles);
+    std::ranges::sort(floats);
+    std::ranges::sort(u64s);
+    std::vector<double> double_queries;
+    std::vector<float> float_queries;
+    std::vector<uint64_t> u64_queries = {0, UINT64_MAX};
+    for (size_t i = 0; i < 1000; ++i) {
+        double_queries.push_back(static_cast<double>(rng() % 10000) / 7.0);
+        float_queries.push_back(static_cast<float>(rng() % 10000) / 3.0f);
+        u64_queries.push_back(u64s[rng() % u64s.size()] + (rng() % 2));
+    }
+    jrmwng::algorithm::layout::veb_layout_t<double> veb_doubles(doubles);
+    jrmwng::algorithm::layout::veb_layout_t<float> veb_floats(floats);
+    jrmwng::algorithm::layout::veb_layout_t<uint64_t> veb_u64s(u64s);
+    ExpectMatchesStd(doubles, double_queries, [&](double q) { return veb_doubles.lower_bound(q); });
+    ExpectMatchesStd(floats, float_queries, [&](float q) { return veb_floats.lower_bound(q); });
+    ExpectMatchesStd(u64s, u64_queries, [&](uint64_t q) { return veb_u64s.lower_bound(q); });
+}
+
+TEST(LowerBoundVebTest, GreaterComparator) {
+    std::vector<int> vec = {9, 7, 7, 4, 1};
+    jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+    ExpectMatchesStd(vec, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, [&](int q) { return veb.lower_bound(q, std::greater<int>()); }, std::greater<int>());
+}
+
+TEST(LowerBoundVebTest, ViewOverExternalNodes) {
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i] = static_cast<int>(i * 3);
+    }
+    jrmwng::algorithm::layout::veb_layout_t<int> veb(vec);
+    std::vector<int> copy(veb.view().nodes().begin(), veb.view().nodes().end());
+    jrmwng::algorithm::layout::veb_view_t<int> view(copy, vec.size());
+    EXPECT_EQ(view.lower_bound(301), 101u);
+    EXPECT_EQ(veb.bytes(), copy.size() * sizeof(int));
+    EXPECT_THROW(jrmwng::algorithm::layout::veb_view_t<int>(std::span<int const>(copy).first(8), vec.size()), std::invalid_argument);
+}
+
+TEST(LowerBoundVebTest, ThreadedBuildMatchesSequential) {
+    std::mt19937 rng(7);
+    for (size_t size : {0u, 1u, 100u, 5000u, 300000u}) {
+        std::vector<int> vec(size);
+        for (int &x : vec) {
+            x = static_cast<int>(rng() % 1000000);
+        }
+        std::sort(vec.begin(), vec.end());
+        jrmwng::algorithm::layout::veb_layout_t<int> sequential(vec);
+        for (size_t threads : {2u, 3u, 8u}) {
+            jrmwng::algorithm::layout::veb_layout_t<int> threaded(vec, threads);
+            EXPECT_TRUE(std::ranges::equal(threaded.view().nodes(), sequential.view().nodes())) << size << " keys, " << threads << " threads";
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}